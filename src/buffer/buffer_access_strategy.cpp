@@ -0,0 +1,37 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// buffer_access_strategy.cpp
+//
+// Identification: src/buffer/buffer_access_strategy.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/buffer_access_strategy.h"
+
+#include "buffer/buffer_pool_manager_instance.h"
+
+namespace bustub {
+
+BufferAccessStrategy::~BufferAccessStrategy() {
+  for (auto &ring : rings_) {
+    ring.owner_->ReleaseRing(&ring);
+  }
+}
+
+BufferAccessStrategy::Ring *BufferAccessStrategy::GetRing(BufferPoolManagerInstance *instance) {
+  std::scoped_lock lock(latch_);
+  for (auto &ring : rings_) {
+    if (ring.owner_ == instance) {
+      return &ring;
+    }
+  }
+  rings_.emplace_back();
+  rings_.back().owner_ = instance;
+  return &rings_.back();
+}
+
+}  // namespace bustub
@@ -17,32 +17,43 @@
 namespace bustub {
 
 BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager,
-                                                     LogManager *log_manager)
-    : BufferPoolManagerInstance(pool_size, 1, 0, disk_manager, log_manager) {}
+                                                     LogManager *log_manager, Replacer *replacer)
+    : BufferPoolManagerInstance(pool_size, 1, 0, disk_manager, log_manager, replacer) {}
 
 BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, uint32_t num_instances, uint32_t instance_index,
-                                                     DiskManager *disk_manager, LogManager *log_manager)
+                                                     DiskManager *disk_manager, LogManager *log_manager,
+                                                     Replacer *replacer)
     : pool_size_(pool_size),
       num_instances_(num_instances),
       instance_index_(instance_index),
       next_page_id_(instance_index),
       disk_manager_(disk_manager),
-      log_manager_(log_manager) {
+      log_manager_(log_manager),
+      replacer_(replacer),
+      frame_latches_(pool_size),
+      frame_cvs_(pool_size),
+      frame_states_(pool_size),
+      frame_in_ring_(pool_size) {
   BUSTUB_ASSERT(num_instances > 0, "If BPI is not part of a pool, then the pool size should just be 1");
   BUSTUB_ASSERT(
       instance_index < num_instances,
       "BPI index cannot be greater than the number of BPIs in the pool. In non-parallel case, index should just be 1.");
   // We allocate a consecutive memory space for the buffer pool.
   pages_ = new Page[pool_size_];
-  replacer_ = new LRUReplacer(pool_size);
+  if (replacer_ == nullptr) {
+    replacer_ = new LRUReplacer(pool_size);
+  }
 
   // Initially, every page is in the free list.
   for (size_t i = 0; i < pool_size_; ++i) {
     free_list_.emplace_back(static_cast<int>(i));
+    frame_states_[i] = FrameState::READY;
   }
 }
 
 BufferPoolManagerInstance::~BufferPoolManagerInstance() {
+  StopPrefetcher();
+  StopPageCleaner();
   delete[] pages_;
   delete replacer_;
 }
@@ -53,24 +64,57 @@ bool BufferPoolManagerInstance::FlushPgImp(page_id_t page_id) {
     return false;
   }
 
-  std::scoped_lock lock(latch_);
-  auto iter = page_table_.find(page_id);
-  if (iter == page_table_.end()) {
+  // Pinning the page keeps its frame from being reassigned while it is written out. Flushing is not a use of the
+  // page, so the frame keeps its place in the replacer.
+  frame_id_t frame_id;
+  if (!PinCachedFrame(page_id, &frame_id, false)) {
     return false;
   }
-  frame_id_t frame_id = iter->second;
+  WaitForFrame(frame_id);
   Page *page = pages_ + frame_id;
-  disk_manager_->WritePage(page_id, page->GetData());
   page->is_dirty_ = false;
+  disk_manager_->WritePage(page_id, page->GetData());
+  UnpinPgImp(page_id, false);
   return true;
 }
 
 void BufferPoolManagerInstance::FlushAllPgsImp() {
-  std::scoped_lock lock(latch_);
-  for (auto [page_id, frame_id] : page_table_) {
-    Page *page = pages_ + frame_id;
-    disk_manager_->WritePage(page_id, page->GetData());
-    page->is_dirty_ = false;
+  std::vector<page_id_t> page_ids;
+  for (auto &shard : page_table_) {
+    std::shared_lock shard_lock(shard.latch_);
+    for (auto [page_id, frame_id] : shard.table_) {
+      page_ids.emplace_back(page_id);
+    }
+  }
+
+  // Flush in batches with their writes in flight together. As in FlushPgImp(), flushing is not a use of the pages.
+  std::vector<std::pair<page_id_t, frame_id_t>> batch;
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    frame_id_t frame_id;
+    if (PinCachedFrame(page_ids[i], &frame_id, false)) {
+      WaitForFrame(frame_id);
+      batch.emplace_back(page_ids[i], frame_id);
+    }
+    if (batch.size() == GetIOBatchSize() || (i + 1 == page_ids.size() && !batch.empty())) {
+      WritePinnedPages(batch);
+      batch.clear();
+    }
+  }
+}
+
+void BufferPoolManagerInstance::WritePinnedPages(const std::vector<std::pair<page_id_t, frame_id_t>> &pages) {
+  AsyncDiskIO *async_io = GetAsyncIO();
+  std::vector<std::future<bool>> writes;
+  for (auto [page_id, frame_id] : pages) {
+    pages_[frame_id].is_dirty_ = false;
+    writes.emplace_back(async_io->SubmitWrite(page_id, pages_[frame_id].GetData()));
+  }
+  for (size_t i = 0; i < pages.size(); i++) {
+    // A failed write leaves the page dirty so that it is written again later.
+    if (!writes[i].get()) {
+      pages_[pages[i].second].is_dirty_ = true;
+    }
+    UnpinPgImp(pages[i].first, false);
   }
 }
 
@@ -80,37 +124,24 @@ Page *BufferPoolManagerInstance::NewPgImp(page_id_t *page_id) {
   // 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
   // 3.   Update P's metadata, zero out memory and add P to the page table.
   // 4.   Set the page ID output parameter. Return a pointer to P.
-  std::scoped_lock lock(latch_);
+  std::unique_lock lock(latch_);
   frame_id_t frame_id = 0;
-  if (!free_list_.empty()) {
-    frame_id = free_list_.back();
-    free_list_.pop_back();
-  } else if (replacer_->Size() != 0) {
-    replacer_->Victim(&frame_id);
-  } else {
+  page_id_t writeback_page_id;
+  if (!GetVictimFrame(&frame_id, &writeback_page_id)) {
     return nullptr;
   }
-
-  Page *page = pages_ + frame_id;
   *page_id = AllocatePage();
-  if (auto iter = page_table_.find(page->page_id_); iter != page_table_.end()) {
-    page_table_.erase(iter);
-  }
-  page_table_[*page_id] = frame_id;
+  InstallPage(frame_id, *page_id);
+  lock.unlock();
 
-  if (page->IsDirty()) {
-    disk_manager_->WritePage(page->page_id_, page->GetData());
-  }
+  Page *page = pages_ + frame_id;
+  FinishWriteBack(frame_id, writeback_page_id);
   page->ResetMemory();
-  page->is_dirty_ = false;
-  page->pin_count_ = 1;
-  page->page_id_ = *page_id;
-  replacer_->Pin(frame_id);
-
+  MarkFrameReady(frame_id);
   return page;
 }
 
-Page *BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) {
+Page *BufferPoolManagerInstance::FetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) {
   // 1.     Search the page table for the requested page (P).
   // 1.1    If P exists, pin it and return it immediately.
   // 1.2    If P does not exist, find a replacement page (R) from either the free list or the replacer.
@@ -122,43 +153,68 @@ Page *BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) {
     return nullptr;
   }
 
-  std::scoped_lock lock(latch_);
   frame_id_t frame_id = 0;
-  if (auto iter = page_table_.find(page_id); iter != page_table_.end()) {
-    frame_id = iter->second;
-    Page *page = pages_ + frame_id;
-    page->pin_count_++;
-    if (page->pin_count_ == 1) {
-      replacer_->Pin(frame_id);
-    }
-    return page;
+  if (PinCachedFrame(page_id, &frame_id)) {
+    WaitForFrame(frame_id);
+    return pages_ + frame_id;
   }
 
-  if (!free_list_.empty()) {
-    frame_id = free_list_.back();
-    free_list_.pop_back();
-  } else if (replacer_->Size() != 0) {
-    replacer_->Victim(&frame_id);
+  std::unique_lock lock(latch_);
+  // The page may have been evicted with its write back still in flight; reading it now would return stale data.
+  writeback_cv_.wait(lock, [&] { return writing_back_.count(page_id) == 0; });
+  // Another thread may have brought the page in while we were waiting for latch_.
+  if (PinCachedFrame(page_id, &frame_id)) {
+    lock.unlock();
+    WaitForFrame(frame_id);
+    return pages_ + frame_id;
+  }
+
+  page_id_t writeback_page_id;
+  if (strategy != nullptr && GetRingCapacity(strategy) > 0) {
+    auto *ring = strategy->GetRing(this);
+    size_t capacity = GetRingCapacity(strategy);
+    if (!GetRingFrame(ring, capacity, &frame_id, &writeback_page_id)) {
+      return nullptr;
+    }
+    InstallPage(frame_id, page_id);
+    AddToRing(ring, capacity, page_id, frame_id);
   } else {
-    return nullptr;
+    if (!GetVictimFrame(&frame_id, &writeback_page_id)) {
+      return nullptr;
+    }
+    InstallPage(frame_id, page_id);
   }
+  lock.unlock();
 
   Page *page = pages_ + frame_id;
-  if (auto iter = page_table_.find(page->page_id_); iter != page_table_.end()) {
-    page_table_.erase(iter);
-  }
-  page_table_[page_id] = frame_id;
+  FinishWriteBack(frame_id, writeback_page_id);
+  disk_manager_->ReadPage(page_id, page->GetData());
+  MarkFrameReady(frame_id);
+  return page;
+}
 
-  if (page->IsDirty()) {
-    disk_manager_->WritePage(page->page_id_, page->GetData());
+void BufferPoolManagerInstance::PrefetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) {
+  // Most read-ahead hints are for pages that are already cached; do not take latch_ for them.
+  if (IsCached(page_id)) {
+    return;
   }
-  disk_manager_->ReadPage(page_id, page->GetData());
-  page->is_dirty_ = false;
-  page->pin_count_ = 1;
-  page->page_id_ = page_id;
-  replacer_->Pin(frame_id);
 
-  return page;
+  std::scoped_lock lock(latch_);
+  // A page that has not been allocated has nothing on disk, and reading it in would map the page before NewPage does.
+  if (page_id >= next_page_id_ || prefetch_queue_.size() >= PREFETCH_QUEUE_SIZE) {
+    return;
+  }
+  PrefetchRequest request{page_id, nullptr, 0};
+  if (strategy != nullptr && GetRingCapacity(strategy) > 0) {
+    request.ring_ = strategy->GetRing(this);
+    request.ring_capacity_ = GetRingCapacity(strategy);
+  }
+  prefetch_queue_.emplace_back(request);
+  if (prefetch_thread_ == nullptr) {
+    prefetch_running_ = true;
+    prefetch_thread_ = new std::thread([this] { RunPrefetcher(); });
+  }
+  prefetch_cv_.notify_one();
 }
 
 bool BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) {
@@ -172,28 +228,32 @@ bool BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) {
   }
 
   std::scoped_lock lock(latch_);
-  auto iter = page_table_.find(page_id);
-  if (iter == page_table_.end()) {
+  auto &shard = GetShard(page_id);
+  std::unique_lock shard_lock(shard.latch_);
+  auto iter = shard.table_.find(page_id);
+  if (iter == shard.table_.end()) {
     return true;
   }
 
   frame_id_t frame_id = iter->second;
   Page *page = pages_ + frame_id;
 
+  // A frame that is still loading is pinned by its loader, so an unpinned frame is always READY.
   if (page->pin_count_ != 0) {
     return false;
   }
 
-  page_table_.erase(iter);
+  shard.table_.erase(iter);
+  shard_lock.unlock();
+  // The frame is unpinned, so it is sitting in the replacer; it must not be handed out from there as well.
+  replacer_->Remove(frame_id);
   free_list_.emplace_back(frame_id);
 
-  if (page->IsDirty()) {
-    disk_manager_->WritePage(page_id, page->GetData());
-  }
+  // The content of a deleted page is never read again, so it is dropped without being written back.
   page->is_dirty_ = false;
   page->pin_count_ = 0;
   page->page_id_ = INVALID_PAGE_ID;
-  DeallocatePage(page->page_id_);
+  DeallocatePage(page_id);
 
   return true;
 }
@@ -203,24 +263,381 @@ bool BufferPoolManagerInstance::UnpinPgImp(page_id_t page_id, bool is_dirty) {
     return false;
   }
 
-  std::scoped_lock lock(latch_);
-  auto iter = page_table_.find(page_id);
-  if (iter == page_table_.end()) {
+  auto &shard = GetShard(page_id);
+  std::shared_lock shard_lock(shard.latch_);
+  auto iter = shard.table_.find(page_id);
+  if (iter == shard.table_.end()) {
     return false;
   }
 
   frame_id_t frame_id = iter->second;
   Page *page = pages_ + frame_id;
-  if (page->pin_count_ == 0) {
+  // Mark the page dirty before dropping the pin, so that whoever evicts it is guaranteed to see the flag.
+  if (is_dirty) {
+    page->is_dirty_ = true;
+  }
+  int pin_count = page->pin_count_.load();
+  do {
+    if (pin_count == 0) {
+      return false;
+    }
+  } while (!page->pin_count_.compare_exchange_weak(pin_count, pin_count - 1));
+
+  if (pin_count == 1) {
+    // Re-check under the frame latch: a concurrent fetch may already have pinned the frame again.
+    std::scoped_lock frame_lock(frame_latches_[frame_id]);
+    if (page->pin_count_ == 0 && !frame_in_ring_[frame_id]) {
+      replacer_->Unpin(frame_id);
+    }
+  }
+  return true;
+}
+
+void BufferPoolManagerInstance::PinFrame(frame_id_t frame_id) {
+  Page *page = pages_ + frame_id;
+  if (page->pin_count_++ == 0) {
+    // Re-check under the frame latch: a concurrent unpin may already have released the frame again.
+    std::scoped_lock frame_lock(frame_latches_[frame_id]);
+    if (page->pin_count_ != 0) {
+      replacer_->Pin(frame_id);
+    }
+  }
+}
+
+bool BufferPoolManagerInstance::PinCachedFrame(page_id_t page_id, frame_id_t *frame_id, bool record_access) {
+  auto &shard = GetShard(page_id);
+  std::shared_lock shard_lock(shard.latch_);
+  auto iter = shard.table_.find(page_id);
+  if (iter == shard.table_.end()) {
     return false;
   }
-  page->pin_count_--;
-  page->is_dirty_ = page->is_dirty_ || is_dirty;
+  *frame_id = iter->second;
+  if (record_access) {
+    PinFrame(*frame_id);
+  } else {
+    // The frame may stay in the replacer while pinned; eviction skips pinned frames.
+    pages_[*frame_id].pin_count_++;
+  }
+  return true;
+}
+
+bool BufferPoolManagerInstance::GetVictimFrame(frame_id_t *frame_id, page_id_t *writeback_page_id) {
+  *writeback_page_id = INVALID_PAGE_ID;
+  if (!free_list_.empty()) {
+    *frame_id = free_list_.back();
+    free_list_.pop_back();
+    return true;
+  }
+
+  while (replacer_->Victim(frame_id)) {
+    Page *page = pages_ + *frame_id;
+    {
+      auto &shard = GetShard(page->page_id_);
+      std::unique_lock shard_lock(shard.latch_);
+      // The frame may have been pinned through the page table after it was handed to the replacer. It will be given
+      // back to the replacer when that pin is released.
+      if (page->pin_count_ != 0) {
+        continue;
+      }
+      EvictPage(page, writeback_page_id);
+    }
+    return true;
+  }
+  return false;
+}
+
+void BufferPoolManagerInstance::EvictPage(Page *page, page_id_t *writeback_page_id) {
+  GetShard(page->page_id_).table_.erase(page->page_id_);
+  if (!page->IsDirty()) {
+    return;
+  }
+  page->is_dirty_ = false;
+  *writeback_page_id = page->page_id_;
+  writing_back_.insert(page->page_id_);
+  num_foreground_writebacks_++;
+  // The cleaner fell behind; have it catch up instead of waiting for its next round.
+  if (cleaner_thread_ != nullptr) {
+    {
+      std::scoped_lock cleaner_lock(cleaner_latch_);
+      cleaner_pending_ = true;
+    }
+    cleaner_cv_.notify_one();
+  }
+}
+
+bool BufferPoolManagerInstance::GetRingFrame(BufferAccessStrategy::Ring *ring, size_t capacity, frame_id_t *frame_id,
+                                             page_id_t *writeback_page_id) {
+  if (ring->slots_.size() == capacity) {
+    auto [page_id, ring_frame_id] = ring->slots_[ring->next_];
+    if (page_id != INVALID_PAGE_ID) {
+      auto &shard = GetShard(page_id);
+      std::unique_lock shard_lock(shard.latch_);
+      Page *page = pages_ + ring_frame_id;
+      // The frame can be recycled if it still holds the page the scan read into it and nobody is using that page.
+      if (auto iter = shard.table_.find(page_id);
+          iter != shard.table_.end() && iter->second == ring_frame_id && page->pin_count_ == 0) {
+        *writeback_page_id = INVALID_PAGE_ID;
+        EvictPage(page, writeback_page_id);
+        // The frame is not in the replacer, but a replacer keeping access history must start over for the new page.
+        replacer_->Remove(ring_frame_id);
+        ring->slots_[ring->next_].first = INVALID_PAGE_ID;
+        *frame_id = ring_frame_id;
+        return true;
+      }
+    }
+  }
+  return GetVictimFrame(frame_id, writeback_page_id);
+}
 
-  if (page->pin_count_ == 0) {
+void BufferPoolManagerInstance::AddToRing(BufferAccessStrategy::Ring *ring, size_t capacity, page_id_t page_id,
+                                          frame_id_t frame_id) {
+  // The loader holds the only pin on the frame, so there is no concurrent unpin to order this with.
+  frame_in_ring_[frame_id] = true;
+  if (ring->slots_.size() < capacity) {
+    ring->slots_.emplace_back(page_id, frame_id);
+    return;
+  }
+  ReleaseRingSlot(&ring->slots_[ring->next_]);
+  ring->slots_[ring->next_] = {page_id, frame_id};
+  ring->next_ = (ring->next_ + 1) % capacity;
+}
+
+void BufferPoolManagerInstance::ReleaseRingSlot(std::pair<page_id_t, frame_id_t> *slot) {
+  auto [page_id, frame_id] = *slot;
+  slot->first = INVALID_PAGE_ID;
+  if (page_id == INVALID_PAGE_ID) {
+    return;
+  }
+  auto &shard = GetShard(page_id);
+  std::shared_lock shard_lock(shard.latch_);
+  // The page may have been deleted since, in which case the frame was reset when it was reassigned.
+  if (auto iter = shard.table_.find(page_id); iter == shard.table_.end() || iter->second != frame_id) {
+    return;
+  }
+  std::scoped_lock frame_lock(frame_latches_[frame_id]);
+  frame_in_ring_[frame_id] = false;
+  if (pages_[frame_id].pin_count_ == 0) {
     replacer_->Unpin(frame_id);
   }
-  return true;
+}
+
+void BufferPoolManagerInstance::ReleaseRing(BufferAccessStrategy::Ring *ring) {
+  std::scoped_lock lock(latch_);
+  // The ring goes away with its strategy, so pending read-ahead through it is dropped.
+  prefetch_queue_.erase(std::remove_if(prefetch_queue_.begin(), prefetch_queue_.end(),
+                                       [ring](const PrefetchRequest &request) { return request.ring_ == ring; }),
+                        prefetch_queue_.end());
+  for (auto &slot : ring->slots_) {
+    ReleaseRingSlot(&slot);
+  }
+  ring->slots_.clear();
+  ring->next_ = 0;
+}
+
+void BufferPoolManagerInstance::InstallPage(frame_id_t frame_id, page_id_t page_id) {
+  Page *page = pages_ + frame_id;
+  frame_states_[frame_id] = FrameState::LOADING;
+  frame_in_ring_[frame_id] = false;
+  page->is_dirty_ = false;
+  page->pin_count_ = 1;
+  page->page_id_ = page_id;
+  replacer_->Pin(frame_id);
+
+  auto &shard = GetShard(page_id);
+  std::unique_lock shard_lock(shard.latch_);
+  shard.table_[page_id] = frame_id;
+}
+
+void BufferPoolManagerInstance::FinishWriteBack(frame_id_t frame_id, page_id_t page_id) {
+  if (page_id == INVALID_PAGE_ID) {
+    return;
+  }
+  disk_manager_->WritePage(page_id, pages_[frame_id].GetData());
+  {
+    std::scoped_lock lock(latch_);
+    writing_back_.erase(page_id);
+  }
+  writeback_cv_.notify_all();
+}
+
+void BufferPoolManagerInstance::MarkFrameReady(frame_id_t frame_id) {
+  {
+    std::scoped_lock frame_lock(frame_latches_[frame_id]);
+    frame_states_[frame_id] = FrameState::READY;
+  }
+  frame_cvs_[frame_id].notify_all();
+}
+
+void BufferPoolManagerInstance::WaitForFrame(frame_id_t frame_id) {
+  if (frame_states_[frame_id] == FrameState::READY) {
+    return;
+  }
+  std::unique_lock frame_lock(frame_latches_[frame_id]);
+  frame_cvs_[frame_id].wait(frame_lock, [&] { return frame_states_[frame_id] == FrameState::READY; });
+}
+
+void BufferPoolManagerInstance::RunPageCleaner(size_t clean_target) {
+  std::scoped_lock lock(latch_);
+  if (cleaner_thread_ != nullptr) {
+    return;
+  }
+  clean_target_ = clean_target;
+  cleaner_running_ = true;
+  cleaner_thread_ = new std::thread([this] {
+    std::unique_lock cleaner_lock(cleaner_latch_);
+    while (cleaner_running_) {
+      cleaner_cv_.wait_for(cleaner_lock, page_cleaner_interval,
+                           [this] { return !cleaner_running_ || cleaner_pending_; });
+      if (!cleaner_running_) {
+        break;
+      }
+      cleaner_pending_ = false;
+      cleaner_lock.unlock();
+      CleanColdPages();
+      cleaner_lock.lock();
+    }
+  });
+}
+
+void BufferPoolManagerInstance::StopPageCleaner() {
+  std::thread *cleaner_thread;
+  {
+    std::scoped_lock lock(latch_);
+    cleaner_thread = cleaner_thread_;
+    cleaner_thread_ = nullptr;
+  }
+  if (cleaner_thread == nullptr) {
+    return;
+  }
+  {
+    std::scoped_lock cleaner_lock(cleaner_latch_);
+    cleaner_running_ = false;
+  }
+  cleaner_cv_.notify_one();
+  cleaner_thread->join();
+  delete cleaner_thread;
+}
+
+void BufferPoolManagerInstance::CleanColdPages() {
+  // Frames only change pages under latch_, so the page ids read here are consistent with the frames.
+  std::vector<std::pair<page_id_t, frame_id_t>> candidates;
+  {
+    std::scoped_lock lock(latch_);
+    for (frame_id_t frame_id : replacer_->PeekVictims(clean_target_)) {
+      if (pages_[frame_id].IsDirty()) {
+        candidates.emplace_back(pages_[frame_id].page_id_, frame_id);
+      }
+    }
+  }
+
+  std::vector<std::pair<page_id_t, frame_id_t>> batch;
+  for (size_t i = 0; i < candidates.size(); i++) {
+    auto [page_id, frame_id] = candidates[i];
+    Page *page = pages_ + frame_id;
+    {
+      auto &shard = GetShard(page_id);
+      std::shared_lock shard_lock(shard.latch_);
+      auto iter = shard.table_.find(page_id);
+      // Only take frames nobody is using. The pin keeps the frame from being reassigned during the write but,
+      // unlike a regular fetch, leaves it at its place in the replacer.
+      int pin_count = 0;
+      if (iter != shard.table_.end() && iter->second == frame_id &&
+          page->pin_count_.compare_exchange_strong(pin_count, 1)) {
+        batch.emplace_back(page_id, frame_id);
+      }
+    }
+    if (batch.size() == GetIOBatchSize() || (i + 1 == candidates.size() && !batch.empty())) {
+      WritePinnedPages(batch);
+      num_pages_cleaned_ += batch.size();
+      batch.clear();
+    }
+  }
+}
+
+void BufferPoolManagerInstance::RunPrefetcher() {
+  std::unique_lock lock(latch_);
+  while (true) {
+    prefetch_cv_.wait(lock, [this] { return !prefetch_running_ || !prefetch_queue_.empty(); });
+    if (!prefetch_running_) {
+      break;
+    }
+    // Load a batch of the queued pages with their reads in flight together.
+    std::vector<std::pair<page_id_t, frame_id_t>> loads;
+    std::vector<std::pair<frame_id_t, page_id_t>> writebacks;
+    while (!prefetch_queue_.empty() && loads.size() < GetIOBatchSize()) {
+      PrefetchRequest request = prefetch_queue_.front();
+      prefetch_queue_.pop_front();
+
+      // A page whose write back is in flight was evicted recently; it is read again on demand rather than waited for.
+      if (writing_back_.count(request.page_id_) != 0 || IsCached(request.page_id_)) {
+        continue;
+      }
+      // The frame is pinned while it loads. Read-ahead must not take the last unpinned frame from a foreground fetch.
+      if (free_list_.size() + replacer_->Size() < 2) {
+        continue;
+      }
+
+      frame_id_t frame_id;
+      page_id_t writeback_page_id;
+      if (request.ring_ != nullptr) {
+        if (!GetRingFrame(request.ring_, request.ring_capacity_, &frame_id, &writeback_page_id)) {
+          continue;
+        }
+        InstallPage(frame_id, request.page_id_);
+        AddToRing(request.ring_, request.ring_capacity_, request.page_id_, frame_id);
+      } else {
+        if (!GetVictimFrame(&frame_id, &writeback_page_id)) {
+          continue;
+        }
+        InstallPage(frame_id, request.page_id_);
+      }
+      loads.emplace_back(request.page_id_, frame_id);
+      if (writeback_page_id != INVALID_PAGE_ID) {
+        writebacks.emplace_back(frame_id, writeback_page_id);
+      }
+    }
+    if (loads.empty()) {
+      continue;
+    }
+    lock.unlock();
+
+    // A fetch of one of the pages in the meantime finds its frame LOADING and waits for the read to complete.
+    for (auto [frame_id, writeback_page_id] : writebacks) {
+      FinishWriteBack(frame_id, writeback_page_id);
+    }
+    AsyncDiskIO *async_io = GetAsyncIO();
+    std::vector<std::future<bool>> reads;
+    for (auto [page_id, frame_id] : loads) {
+      reads.emplace_back(async_io->SubmitRead(page_id, pages_[frame_id].GetData()));
+    }
+    for (size_t i = 0; i < loads.size(); i++) {
+      auto [page_id, frame_id] = loads[i];
+      if (!reads[i].get()) {
+        // Retry the read synchronously rather than leave garbage in the frame.
+        disk_manager_->ReadPage(page_id, pages_[frame_id].GetData());
+      }
+      MarkFrameReady(frame_id);
+      num_pages_prefetched_++;
+      UnpinPgImp(page_id, false);
+    }
+    lock.lock();
+  }
+}
+
+void BufferPoolManagerInstance::StopPrefetcher() {
+  std::thread *prefetch_thread;
+  {
+    std::scoped_lock lock(latch_);
+    prefetch_thread = prefetch_thread_;
+    prefetch_thread_ = nullptr;
+    prefetch_running_ = false;
+    prefetch_queue_.clear();
+  }
+  prefetch_cv_.notify_one();
+  if (prefetch_thread != nullptr) {
+    prefetch_thread->join();
+    delete prefetch_thread;
+  }
 }
 
 page_id_t BufferPoolManagerInstance::AllocatePage() {
@@ -14,16 +14,74 @@
 
 namespace bustub {
 
-ClockReplacer::ClockReplacer(size_t num_pages) {}
+ClockReplacer::ClockReplacer(size_t num_pages) : in_replacer_(num_pages, false), ref_(num_pages, false) {}
 
 ClockReplacer::~ClockReplacer() = default;
 
-bool ClockReplacer::Victim(frame_id_t *frame_id) { return false; }
+bool ClockReplacer::Victim(frame_id_t *frame_id) {
+  std::scoped_lock lock(latch_);
+  if (size_ == 0) {
+    return false;
+  }
+  // Two sweeps are enough: the first one clears every reference bit it passes.
+  while (true) {
+    size_t frame = hand_;
+    hand_ = (hand_ + 1) % in_replacer_.size();
+    if (!in_replacer_[frame]) {
+      continue;
+    }
+    if (ref_[frame]) {
+      ref_[frame] = false;
+      continue;
+    }
+    in_replacer_[frame] = false;
+    size_--;
+    *frame_id = static_cast<frame_id_t>(frame);
+    return true;
+  }
+}
 
-void ClockReplacer::Pin(frame_id_t frame_id) {}
+void ClockReplacer::Pin(frame_id_t frame_id) {
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= in_replacer_.size()) {
+    return;
+  }
+  std::scoped_lock lock(latch_);
+  if (in_replacer_[frame_id]) {
+    in_replacer_[frame_id] = false;
+    size_--;
+  }
+}
 
-void ClockReplacer::Unpin(frame_id_t frame_id) {}
+void ClockReplacer::Unpin(frame_id_t frame_id) {
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= in_replacer_.size()) {
+    return;
+  }
+  std::scoped_lock lock(latch_);
+  if (!in_replacer_[frame_id]) {
+    in_replacer_[frame_id] = true;
+    ref_[frame_id] = true;
+    size_++;
+  }
+}
 
-size_t ClockReplacer::Size() { return 0; }
+size_t ClockReplacer::Size() {
+  std::scoped_lock lock(latch_);
+  return size_;
+}
+
+std::vector<frame_id_t> ClockReplacer::PeekVictims(size_t max_frames) {
+  std::scoped_lock lock(latch_);
+  // Frames the hand would take without a second look come first, then the ones it would clear on the way.
+  std::vector<frame_id_t> victims;
+  for (bool referenced : {false, true}) {
+    for (size_t i = 0; i < in_replacer_.size() && victims.size() < max_frames; i++) {
+      size_t frame = (hand_ + i) % in_replacer_.size();
+      if (in_replacer_[frame] && ref_[frame] == referenced) {
+        victims.emplace_back(static_cast<frame_id_t>(frame));
+      }
+    }
+  }
+  return victims;
+}
 
 }  // namespace bustub
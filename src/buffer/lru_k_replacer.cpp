@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// lru_k_replacer.cpp
+//
+// Identification: src/buffer/lru_k_replacer.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/lru_k_replacer.h"
+
+#include "common/macros.h"
+
+namespace bustub {
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k, size_t correlated_reference_period)
+    : k_(k), correlated_reference_period_(correlated_reference_period), frames_(num_pages) {
+  BUSTUB_ASSERT(k > 0, "LRU-K needs to remember at least one reference");
+}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+bool LRUKReplacer::Victim(frame_id_t *frame_id) {
+  std::scoped_lock lock(latch_);
+  auto victims = VictimOrder(1);
+  if (victims.empty()) {
+    return false;
+  }
+  *frame_id = victims[0];
+  evictable_.erase(KeyOf(*frame_id));
+  frames_[*frame_id] = FrameHistory();
+  return true;
+}
+
+void LRUKReplacer::Pin(frame_id_t frame_id) {
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= frames_.size()) {
+    return;
+  }
+  std::scoped_lock lock(latch_);
+  auto &frame = frames_[frame_id];
+  if (frame.evictable_) {
+    evictable_.erase(KeyOf(frame_id));
+    frame.evictable_ = false;
+  }
+
+  uint64_t now = ++current_time_;
+  if (frame.history_.empty()) {
+    frame.history_.push_front(now);
+  } else if (now - frame.last_ >= correlated_reference_period_) {
+    // Close the correlated period: shift the older references by its length so that it counts as a single reference.
+    uint64_t correlated_period = frame.last_ - frame.history_.front();
+    for (auto &time : frame.history_) {
+      time += correlated_period;
+    }
+    frame.history_.push_front(now);
+    if (frame.history_.size() > k_) {
+      frame.history_.pop_back();
+    }
+  }
+  frame.last_ = now;
+}
+
+void LRUKReplacer::Unpin(frame_id_t frame_id) {
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= frames_.size()) {
+    return;
+  }
+  std::scoped_lock lock(latch_);
+  auto &frame = frames_[frame_id];
+  if (!frame.evictable_) {
+    frame.evictable_ = true;
+    evictable_.insert(KeyOf(frame_id));
+  }
+}
+
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= frames_.size()) {
+    return;
+  }
+  std::scoped_lock lock(latch_);
+  if (frames_[frame_id].evictable_) {
+    evictable_.erase(KeyOf(frame_id));
+  }
+  frames_[frame_id] = FrameHistory();
+}
+
+size_t LRUKReplacer::Size() {
+  std::scoped_lock lock(latch_);
+  return evictable_.size();
+}
+
+std::vector<frame_id_t> LRUKReplacer::PeekVictims(size_t max_frames) {
+  std::scoped_lock lock(latch_);
+  return VictimOrder(max_frames);
+}
+
+LRUKReplacer::EvictionKey LRUKReplacer::KeyOf(frame_id_t frame_id) const {
+  const auto &frame = frames_[frame_id];
+  if (frame.history_.size() < k_) {
+    return {false, frame.last_, frame_id};
+  }
+  return {true, frame.history_.back(), frame_id};
+}
+
+bool LRUKReplacer::InCorrelatedPeriod(frame_id_t frame_id) const {
+  const auto &frame = frames_[frame_id];
+  return !frame.history_.empty() && current_time_ - frame.last_ < correlated_reference_period_;
+}
+
+std::vector<frame_id_t> LRUKReplacer::VictimOrder(size_t max_frames) const {
+  std::vector<frame_id_t> victims;
+  for (bool correlated : {false, true}) {
+    for (auto iter = evictable_.begin(); iter != evictable_.end() && victims.size() < max_frames; ++iter) {
+      frame_id_t frame_id = std::get<2>(*iter);
+      if (InCorrelatedPeriod(frame_id) == correlated) {
+        victims.emplace_back(frame_id);
+      }
+    }
+  }
+  return victims;
+}
+
+}  // namespace bustub
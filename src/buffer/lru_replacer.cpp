@@ -66,4 +66,14 @@ size_t LRUReplacer::Size() {
   return unpinned_pages_.size();
 }
 
+std::vector<frame_id_t> LRUReplacer::PeekVictims(size_t max_frames) {
+  std::shared_lock rlock(r_mu_);
+  std::scoped_lock wlock(w_mu_);
+  std::vector<frame_id_t> victims;
+  for (auto iter = unpinned_pages_.begin(); iter != unpinned_pages_.end() && victims.size() < max_frames; ++iter) {
+    victims.emplace_back(*iter);
+  }
+  return victims;
+}
+
 }  // namespace bustub
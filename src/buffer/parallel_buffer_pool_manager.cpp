@@ -35,15 +35,33 @@ ParallelBufferPoolManager::~ParallelBufferPoolManager() {
 
 size_t ParallelBufferPoolManager::GetPoolSize() { return num_instances_ * pool_size_; }
 
+void ParallelBufferPoolManager::RunPageCleaner(size_t clean_target) {
+  for (size_t i = 0; i < num_instances_; i++) {
+    managers_[i]->RunPageCleaner(clean_target);
+  }
+}
+
+void ParallelBufferPoolManager::StopPageCleaner() {
+  for (size_t i = 0; i < num_instances_; i++) {
+    managers_[i]->StopPageCleaner();
+  }
+}
+
 BufferPoolManager *ParallelBufferPoolManager::GetBufferPoolManager(page_id_t page_id) {
   // Get BufferPoolManager responsible for handling given page id. You can use this method in your other methods.
   return managers_[page_id % num_instances_];
 }
 
-Page *ParallelBufferPoolManager::FetchPgImp(page_id_t page_id) {
+Page *ParallelBufferPoolManager::FetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) {
   // Fetch page for page_id from responsible BufferPoolManagerInstance
   auto manager = GetBufferPoolManager(page_id);
-  return manager->FetchPage(page_id);
+  return manager->FetchPageWithStrategy(page_id, strategy);
+}
+
+void ParallelBufferPoolManager::PrefetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) {
+  // Read ahead page_id through the responsible BufferPoolManagerInstance
+  auto manager = GetBufferPoolManager(page_id);
+  manager->Prefetch(page_id, strategy);
 }
 
 bool ParallelBufferPoolManager::UnpinPgImp(page_id_t page_id, bool is_dirty) {
@@ -0,0 +1,176 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// task_scheduler.cpp
+//
+// Identification: src/common/task_scheduler.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/task_scheduler.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace bustub {
+
+/** The shared state of a running job; slots that start late hold on to it after Run() has returned. */
+struct TaskScheduler::Job {
+  /** The tasks of one slot, guarded by their own latch so that stealing does not contend with other slots. */
+  struct SlotTasks {
+    std::mutex latch_;
+    std::deque<size_t> tasks_;
+  };
+
+  Job(size_t num_slots, const std::function<void(size_t, size_t)> &task) : task_(task), slots_(num_slots) {}
+
+  /** Take the next task for a slot: its own first task, or else the last task of another slot. */
+  bool Take(size_t slot, size_t *task) {
+    for (size_t i = 0; i < slots_.size(); i++) {
+      auto &victim = slots_[(slot + i) % slots_.size()];
+      std::scoped_lock lock(victim.latch_);
+      if (victim.tasks_.empty()) {
+        continue;
+      }
+      if (i == 0) {
+        *task = victim.tasks_.front();
+        victim.tasks_.pop_front();
+      } else {
+        *task = victim.tasks_.back();
+        victim.tasks_.pop_back();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  /** Drop all tasks that have not started yet. */
+  void Cancel() {
+    for (auto &slot : slots_) {
+      std::scoped_lock lock(slot.latch_);
+      slot.tasks_.clear();
+    }
+  }
+
+  const std::function<void(size_t, size_t)> &task_;
+  std::vector<SlotTasks> slots_;
+
+  /** Protects the members below. */
+  std::mutex latch_;
+  std::condition_variable cv_;
+  /** The next slot a worker joining the job takes. */
+  size_t next_slot_{1};
+  /** The number of workers running a slot. */
+  size_t num_active_{0};
+  /** True once the calling thread has run out of tasks; workers no longer join the job. */
+  bool closed_{false};
+  /** The first exception thrown by a task. */
+  std::exception_ptr exception_;
+};
+
+TaskScheduler::TaskScheduler(size_t num_workers) {
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back(&TaskScheduler::WorkerLoop, this);
+  }
+}
+
+TaskScheduler::~TaskScheduler() {
+  {
+    std::scoped_lock lock(latch_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+TaskScheduler *TaskScheduler::GetDefault() {
+  static TaskScheduler scheduler(std::max(std::thread::hardware_concurrency(), 2U) - 1);
+  return &scheduler;
+}
+
+void TaskScheduler::Run(size_t num_tasks, size_t num_slots, const std::function<void(size_t, size_t)> &task) {
+  num_slots = std::max<size_t>(1, std::min({num_slots, num_tasks, workers_.size() + 1}));
+  auto job = std::make_shared<Job>(num_slots, task);
+  // Hand out contiguous ranges of tasks, so that each slot works on neighbouring morsels.
+  for (size_t slot = 0; slot < num_slots; slot++) {
+    for (size_t i = num_tasks * slot / num_slots; i < num_tasks * (slot + 1) / num_slots; i++) {
+      job->slots_[slot].tasks_.push_back(i);
+    }
+  }
+
+  if (num_slots > 1) {
+    {
+      std::scoped_lock lock(latch_);
+      for (size_t i = 1; i < num_slots; i++) {
+        queue_.emplace_back([job] {
+          size_t slot;
+          {
+            std::scoped_lock job_lock(job->latch_);
+            if (job->closed_) {
+              return;
+            }
+            slot = job->next_slot_++;
+            job->num_active_++;
+          }
+          RunSlot(job.get(), slot);
+          {
+            std::scoped_lock job_lock(job->latch_);
+            job->num_active_--;
+          }
+          job->cv_.notify_all();
+        });
+      }
+    }
+    cv_.notify_all();
+  }
+
+  RunSlot(job.get(), 0);
+
+  // Wait for the workers that joined the job; the ones that did not will find it closed.
+  std::unique_lock job_lock(job->latch_);
+  job->closed_ = true;
+  job->cv_.wait(job_lock, [&] { return job->num_active_ == 0; });
+  if (job->exception_) {
+    std::rethrow_exception(job->exception_);
+  }
+}
+
+void TaskScheduler::RunSlot(Job *job, size_t slot) {
+  size_t task;
+  while (job->Take(slot, &task)) {
+    try {
+      job->task_(task, slot);
+    } catch (...) {
+      {
+        std::scoped_lock lock(job->latch_);
+        if (!job->exception_) {
+          job->exception_ = std::current_exception();
+        }
+      }
+      job->Cancel();
+    }
+  }
+}
+
+void TaskScheduler::WorkerLoop() {
+  while (true) {
+    std::function<void()> slot;
+    {
+      std::unique_lock lock(latch_);
+      cv_.wait(lock, [&] { return shutdown_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      slot = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    slot();
+  }
+}
+
+}  // namespace bustub
@@ -1,66 +1,315 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// aggregation_executor.cpp
-//
-// Identification: src/execution/aggregation_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-#include <memory>
-#include <vector>
-
-#include "execution/executors/aggregation_executor.h"
-
-namespace bustub {
-
-AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
-                                         std::unique_ptr<AbstractExecutor> &&child)
-    : AbstractExecutor(exec_ctx),
-      plan_(plan),
-      child_(std::move(child)),
-      aht_(plan->GetAggregates(), plan->GetAggregateTypes()),
-      aht_iterator_(aht_.Begin()) {}
-
-void AggregationExecutor::Init() {
-  child_->Init();
-
-  Tuple tuple;
-  RID rid;
-
-  while (child_->Next(&tuple, &rid)) {
-    aht_.InsertCombine(MakeAggregateKey(&tuple), MakeAggregateValue(&tuple));
-  }
-  aht_iterator_ = aht_.Begin();
-  output_columns_ = plan_->OutputSchema()->GetColumns();
-}
-
-bool AggregationExecutor::Next(Tuple *tuple, RID *rid) {
-  std::vector<Value> group_bys;
-  std::vector<Value> aggregates;
-  do {
-    if (aht_iterator_ == aht_.End()) {
-      return false;
-    }
-
-    group_bys = aht_iterator_.Key().group_bys_;
-    aggregates = aht_iterator_.Val().aggregates_;
-
-    ++aht_iterator_;
-  } while (plan_->GetHaving() != nullptr &&
-           !plan_->GetHaving()->EvaluateAggregate(group_bys, aggregates).GetAs<bool>());
-
-  std::vector<Value> values;
-  for (auto &column : output_columns_) {
-    values.emplace_back(column.GetExpr()->EvaluateAggregate(group_bys, aggregates));
-  }
-
-  *tuple = Tuple(values, plan_->OutputSchema());
-  return true;
-}
-
-const AbstractExecutor *AggregationExecutor::GetChildExecutor() const { return child_.get(); }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_executor.cpp
+//
+// Identification: src/execution/aggregation_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "common/exception.h"
+#include "execution/executors/aggregation_executor.h"
+
+namespace bustub {
+
+AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_(std::move(child)),
+      aht_(plan->GetAggregates(), plan->GetAggregateTypes()),
+      aht_iterator_(aht_.Begin()) {}
+
+void AggregationExecutor::Init() {
+  child_->Init();
+  aht_.Clear();
+  ranges_.clear();
+  range_ = 0;
+  partitions_.clear();
+  spilled_ = false;
+  MakeSpillSchema();
+
+  // Evaluate the group-bys and aggregates over whole batches of the input, and only combine them row by row.
+  if (!ParallelAggregate()) {
+    std::vector<ColumnVector> group_by_columns(plan_->GetGroupBys().size());
+    std::vector<ColumnVector> aggregate_columns(plan_->GetAggregates().size());
+    VectorBatch batch;
+    while (child_->NextBatch(&batch)) {
+      AggregateBatch(batch, &aht_, 0, &group_by_columns, &aggregate_columns);
+      if (aht_.GetSize() > exec_ctx_->GetMemoryBudget()) {
+        SpillGroups(&aht_);
+      }
+    }
+    if (spilled_) {
+      SpillGroups(&aht_);
+    }
+  }
+  // Once spilled, aht_ is empty, and NextGroup() merges the partitions into it one at a time.
+  aht_iterator_ = OutputTable()->Begin();
+  output_columns_ = plan_->OutputSchema()->GetColumns();
+}
+
+void AggregationExecutor::AggregateBatch(const VectorBatch &batch, SimpleAggregationHashTable *ahts, size_t range_bits,
+                                         std::vector<ColumnVector> *group_by_columns,
+                                         std::vector<ColumnVector> *aggregate_columns) {
+  const Schema *child_schema = child_->GetOutputSchema();
+  const auto &group_by_exprs = plan_->GetGroupBys();
+  const auto &aggregate_exprs = plan_->GetAggregates();
+  for (uint32_t i = 0; i < group_by_exprs.size(); i++) {
+    group_by_exprs[i]->EvaluateBatch(batch, child_schema, &(*group_by_columns)[i]);
+  }
+  for (uint32_t i = 0; i < aggregate_exprs.size(); i++) {
+    aggregate_exprs[i]->EvaluateBatch(batch, child_schema, &(*aggregate_columns)[i]);
+  }
+  for (auto row : batch.GetSelection()) {
+    AggregateKey key;
+    for (const auto &column : *group_by_columns) {
+      key.group_bys_.emplace_back(column.GetValue(row));
+    }
+    AggregateValue value;
+    for (const auto &column : *aggregate_columns) {
+      value.aggregates_.emplace_back(column.GetValue(row));
+    }
+    size_t range = range_bits == 0 ? 0 : RangeOf(std::hash<AggregateKey>{}(key), range_bits);
+    ahts[range].InsertCombine(key, value);
+  }
+}
+
+bool AggregationExecutor::ParallelAggregate() {
+  size_t parallelism = exec_ctx_->GetParallelism();
+  if (parallelism <= 1) {
+    return false;
+  }
+  // Make more ranges than threads, so that the merge stays balanced when some ranges hold more groups.
+  size_t range_bits = 0;
+  while ((static_cast<size_t>(1) << range_bits) < 2 * parallelism) {
+    range_bits++;
+  }
+  size_t num_ranges = static_cast<size_t>(1) << range_bits;
+  std::vector<std::vector<SimpleAggregationHashTable>> partials(
+      parallelism, std::vector<SimpleAggregationHashTable>(
+                       num_ranges, SimpleAggregationHashTable(plan_->GetAggregates(), plan_->GetAggregateTypes())));
+  std::vector<std::vector<ColumnVector>> group_by_columns(parallelism,
+                                                          std::vector<ColumnVector>(plan_->GetGroupBys().size()));
+  std::vector<std::vector<ColumnVector>> aggregate_columns(parallelism,
+                                                           std::vector<ColumnVector>(plan_->GetAggregates().size()));
+  size_t budget = exec_ctx_->GetMemoryBudget() / parallelism;
+  bool parallel = child_->ParallelBatches([&](size_t slot, VectorBatch *batch) {
+    AggregateBatch(*batch, partials[slot].data(), range_bits, &group_by_columns[slot], &aggregate_columns[slot]);
+    size_t size = 0;
+    for (const auto &partial : partials[slot]) {
+      size += partial.GetSize();
+    }
+    if (size > budget) {
+      std::lock_guard<std::mutex> guard(spill_latch_);
+      for (auto &partial : partials[slot]) {
+        SpillGroups(&partial);
+      }
+    }
+  });
+  if (!parallel) {
+    return false;
+  }
+  if (spilled_) {
+    for (auto &slot_partials : partials) {
+      for (auto &partial : slot_partials) {
+        SpillGroups(&partial);
+      }
+    }
+    return true;
+  }
+
+  // The groups of a range are merged by a single task, into the partial of the first slot.
+  ranges_ = std::move(partials[0]);
+  exec_ctx_->GetTaskScheduler()->Run(num_ranges, parallelism, [&](size_t range, size_t /*slot*/) {
+    for (size_t i = 1; i < parallelism; i++) {
+      ranges_[range].Merge(partials[i][range]);
+      partials[i][range].Clear();
+    }
+  });
+  return true;
+}
+
+void AggregationExecutor::MakeSpillSchema() {
+  std::vector<Column> columns;
+  const auto &group_by_exprs = plan_->GetGroupBys();
+  for (uint32_t i = 0; i < group_by_exprs.size(); i++) {
+    std::string name = "group_by_" + std::to_string(i);
+    TypeId type = group_by_exprs[i]->GetReturnType();
+    if (type == TypeId::VARCHAR) {
+      columns.emplace_back(name, type, PAGE_SIZE);
+    } else {
+      columns.emplace_back(name, type);
+    }
+  }
+  const auto &aggregate_exprs = plan_->GetAggregates();
+  const auto &aggregate_types = plan_->GetAggregateTypes();
+  for (uint32_t i = 0; i < aggregate_exprs.size(); i++) {
+    // Aggregates start out as integers. A count stays one, sums and extremes take on a wider numeric input type.
+    TypeId type = TypeId::INTEGER;
+    if (aggregate_types[i] != AggregationType::CountAggregate) {
+      switch (aggregate_exprs[i]->GetReturnType()) {
+        case TypeId::TINYINT:
+        case TypeId::SMALLINT:
+        case TypeId::INTEGER:
+          break;
+        case TypeId::BIGINT:
+          type = TypeId::BIGINT;
+          break;
+        case TypeId::DECIMAL:
+          type = TypeId::DECIMAL;
+          break;
+        default:
+          throw Exception(ExceptionType::INCOMPATIBLE_TYPE, "only counts can aggregate a non-numeric input");
+      }
+    }
+    columns.emplace_back("aggregate_" + std::to_string(i), type);
+  }
+  spill_schema_ = std::make_unique<Schema>(columns);
+}
+
+void AggregationExecutor::SpillGroups(SimpleAggregationHashTable *aht) {
+  if (!spilled_) {
+    BufferPoolManager *bpm = exec_ctx_->GetBufferPoolManager();
+    for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+      partitions_.emplace_back(Partition{std::make_unique<SpillFile>(bpm), 0});
+    }
+    spilled_ = true;
+  }
+  const auto &columns = spill_schema_->GetColumns();
+  std::vector<Value> values;
+  for (auto iter = aht->Begin(); iter != aht->End(); ++iter) {
+    values.clear();
+    for (const auto &value : iter.Key().group_bys_) {
+      values.emplace_back(value);
+    }
+    for (const auto &value : iter.Val().aggregates_) {
+      values.emplace_back(value);
+    }
+    for (uint32_t i = 0; i < values.size(); i++) {
+      if (values[i].GetTypeId() != columns[i].GetType()) {
+        values[i] = values[i].CastAs(columns[i].GetType());
+      }
+    }
+    size_t partition = PartitionOf(std::hash<AggregateKey>{}(iter.Key()), 0);
+    partitions_[partition].file_->Append(Tuple(values, spill_schema_.get()));
+  }
+  aht->Clear();
+}
+
+void AggregationExecutor::ReadGroup(const Tuple &tuple, AggregateKey *agg_key, AggregateValue *agg_val) {
+  size_t num_group_bys = plan_->GetGroupBys().size();
+  agg_key->group_bys_.clear();
+  agg_val->aggregates_.clear();
+  for (uint32_t i = 0; i < spill_schema_->GetColumnCount(); i++) {
+    Value value = tuple.GetValue(spill_schema_.get(), i);
+    if (i < num_group_bys) {
+      agg_key->group_bys_.emplace_back(std::move(value));
+    } else {
+      agg_val->aggregates_.emplace_back(std::move(value));
+    }
+  }
+}
+
+void AggregationExecutor::Repartition(Partition *partition) {
+  size_t first = partitions_.size();
+  size_t level = partition->level_ + 1;
+  BufferPoolManager *bpm = exec_ctx_->GetBufferPoolManager();
+  for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+    partitions_.emplace_back(Partition{std::make_unique<SpillFile>(bpm), level});
+  }
+  Tuple tuple;
+  AggregateKey agg_key;
+  AggregateValue agg_val;
+  while (partition->file_->Next(&tuple)) {
+    ReadGroup(tuple, &agg_key, &agg_val);
+    partitions_[first + PartitionOf(std::hash<AggregateKey>{}(agg_key), level)].file_->Append(tuple);
+  }
+}
+
+bool AggregationExecutor::NextTable() {
+  if (range_ + 1 < ranges_.size()) {
+    range_++;
+    aht_iterator_ = ranges_[range_].Begin();
+    return true;
+  }
+  return spilled_ && NextPartition();
+}
+
+bool AggregationExecutor::NextPartition() {
+  aht_.Clear();
+  while (!partitions_.empty()) {
+    Partition partition = std::move(partitions_.back());
+    partitions_.pop_back();
+    if (partition.file_->GetNumTuples() == 0) {
+      continue;
+    }
+    if (partition.file_->GetSize() > exec_ctx_->GetMemoryBudget() && partition.level_ + 1 < MAX_LEVELS) {
+      Repartition(&partition);
+      continue;
+    }
+    Tuple tuple;
+    AggregateKey agg_key;
+    AggregateValue agg_val;
+    while (partition.file_->Next(&tuple)) {
+      ReadGroup(tuple, &agg_key, &agg_val);
+      aht_.MergeGroup(agg_key, agg_val);
+    }
+    aht_iterator_ = aht_.Begin();
+    return true;
+  }
+  return false;
+}
+
+bool AggregationExecutor::NextGroup(std::vector<Value> *values) {
+  std::vector<Value> group_bys;
+  std::vector<Value> aggregates;
+  do {
+    while (aht_iterator_ == OutputTable()->End()) {
+      if (!NextTable()) {
+        return false;
+      }
+    }
+
+    group_bys = aht_iterator_.Key().group_bys_;
+    aggregates = aht_iterator_.Val().aggregates_;
+
+    ++aht_iterator_;
+  } while (plan_->GetHaving() != nullptr &&
+           !plan_->GetHaving()->EvaluateAggregate(group_bys, aggregates).GetAs<bool>());
+
+  values->clear();
+  for (auto &column : output_columns_) {
+    values->emplace_back(column.GetExpr()->EvaluateAggregate(group_bys, aggregates));
+  }
+  return true;
+}
+
+bool AggregationExecutor::Next(Tuple *tuple, RID *rid) {
+  std::vector<Value> values;
+  if (!NextGroup(&values)) {
+    return false;
+  }
+  *tuple = Tuple(values, plan_->OutputSchema());
+  return true;
+}
+
+bool AggregationExecutor::NextBatch(VectorBatch *batch) {
+  batch->Reset(plan_->OutputSchema());
+  std::vector<Value> values;
+  while (!batch->IsFull() && NextGroup(&values)) {
+    batch->AppendValues(values, RID());
+  }
+  return batch->NumSelected() > 0;
+}
+
+const AbstractExecutor *AggregationExecutor::GetChildExecutor() const { return child_.get(); }
+
+}  // namespace bustub
@@ -23,9 +23,13 @@
 #include "execution/executors/index_scan_executor.h"
 #include "execution/executors/insert_executor.h"
 #include "execution/executors/limit_executor.h"
+#include "execution/executors/merge_join_executor.h"
 #include "execution/executors/nested_index_join_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
+#include "execution/executors/radix_hash_join_executor.h"
 #include "execution/executors/seq_scan_executor.h"
+#include "execution/executors/sort_executor.h"
+#include "execution/executors/topn_executor.h"
 #include "execution/executors/update_executor.h"
 #include "storage/index/generic_key.h"
 
@@ -108,9 +112,34 @@ std::unique_ptr<AbstractExecutor> ExecutorFactory::CreateExecutor(ExecutorContex
       auto hash_join_plan = dynamic_cast<const HashJoinPlanNode *>(plan);
       auto left = ExecutorFactory::CreateExecutor(exec_ctx, hash_join_plan->GetLeftPlan());
       auto right = ExecutorFactory::CreateExecutor(exec_ctx, hash_join_plan->GetRightPlan());
+      if (hash_join_plan->GetAlgorithm() == HashJoinAlgorithm::RadixPartitioned) {
+        return std::make_unique<RadixHashJoinExecutor>(exec_ctx, hash_join_plan, std::move(left), std::move(right));
+      }
       return std::make_unique<HashJoinExecutor>(exec_ctx, hash_join_plan, std::move(left), std::move(right));
     }
 
+    // Create a new merge join executor
+    case PlanType::MergeJoin: {
+      auto merge_join_plan = dynamic_cast<const MergeJoinPlanNode *>(plan);
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetLeftPlan());
+      auto right = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetRightPlan());
+      return std::make_unique<MergeJoinExecutor>(exec_ctx, merge_join_plan, std::move(left), std::move(right));
+    }
+
+    // Create a new sort executor
+    case PlanType::Sort: {
+      auto sort_plan = dynamic_cast<const SortPlanNode *>(plan);
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, sort_plan->GetChildPlan());
+      return std::make_unique<SortExecutor>(exec_ctx, sort_plan, std::move(child_executor));
+    }
+
+    // Create a new top-n executor
+    case PlanType::TopN: {
+      auto topn_plan = dynamic_cast<const TopNPlanNode *>(plan);
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, topn_plan->GetChildPlan());
+      return std::make_unique<TopNExecutor>(exec_ctx, topn_plan, std::move(child_executor));
+    }
+
     default:
       UNREACHABLE("Unsupported plan type.");
   }
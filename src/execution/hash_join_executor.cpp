@@ -26,62 +26,267 @@ HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlan
 void HashJoinExecutor::Init() {
   left_executor_->Init();
   right_executor_->Init();
+  // Drop the state of an earlier run, as a nested loop join initializes its inner side once per outer tuple.
+  ht_.Clear();
+  partitions_.clear();
+  right_partition_.reset();
+  spilled_ = false;
+  right_batch_.Reset(plan_->GetRightPlan()->OutputSchema());
+  right_pos_ = 0;
+  match_ = JoinHashTable::NO_ENTRY;
   const AbstractExpression *left_expression = plan_->LeftJoinKeyExpression();
 
-  Tuple left_tuple;
-  RID dummy_rid;  // not actually used
+  // Build the hash table from batches of the left side, evaluating their join keys a column at a time.
+  if (!ParallelBuild()) {
+    const Schema *left_schema = plan_->GetLeftPlan()->OutputSchema();
+    VectorBatch left_batch;
+    ColumnVector left_keys;
+    while (left_executor_->NextBatch(&left_batch)) {
+      left_expression->EvaluateBatch(left_batch, left_schema, &left_keys);
+      for (auto row : left_batch.GetSelection()) {
+        Value value = left_keys.GetValue(row);
+        InsertLeft(HashUtil::HashValue(&value), value, left_batch.GetTuple(row, left_schema));
+      }
+    }
+  }
 
-  while (left_executor_->Next(&left_tuple, &dummy_rid)) {
-    Value value = left_expression->Evaluate(&left_tuple, plan_->GetLeftPlan()->OutputSchema());
-    hash_t hash_value = HashUtil::HashValue(&value);
-    ht_[hash_value].emplace_back(left_tuple);
+  if (spilled_) {
+    // Partition the right side the same way as the left side.
+    const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+    VectorBatch batch;
+    while (right_executor_->NextBatch(&batch)) {
+      plan_->RightJoinKeyExpression()->EvaluateBatch(batch, right_schema, &right_keys_);
+      for (auto row : batch.GetSelection()) {
+        Value value = right_keys_.GetValue(row);
+        partitions_[PartitionOf(HashUtil::HashValue(&value), 0)].right_->Append(batch.GetTuple(row, right_schema));
+      }
+    }
+  }
+}
+
+bool HashJoinExecutor::ParallelBuild() {
+  size_t parallelism = exec_ctx_->GetParallelism();
+  if (parallelism <= 1) {
+    return false;
   }
+  const AbstractExpression *left_expression = plan_->LeftJoinKeyExpression();
+  const Schema *left_schema = plan_->GetLeftPlan()->OutputSchema();
+  std::vector<ColumnVector> left_keys(parallelism);
+  std::vector<std::vector<std::pair<Value, Tuple>>> rows(parallelism);
+  return left_executor_->ParallelBatches([&](size_t slot, VectorBatch *left_batch) {
+    left_expression->EvaluateBatch(*left_batch, left_schema, &left_keys[slot]);
+    rows[slot].clear();
+    for (auto row : left_batch->GetSelection()) {
+      rows[slot].emplace_back(left_keys[slot].GetValue(row), left_batch->GetTuple(row, left_schema));
+    }
+    std::scoped_lock lock(build_latch_);
+    for (auto &[value, tuple] : rows[slot]) {
+      InsertLeft(HashUtil::HashValue(&value), value, std::move(tuple));
+    }
+  });
+}
+
+void HashJoinExecutor::InsertLeft(hash_t hash, const Value &key, Tuple &&tuple) {
+  if (spilled_) {
+    partitions_[PartitionOf(hash, 0)].left_->Append(tuple);
+    return;
+  }
+  ht_.Insert(hash, key, std::move(tuple));
+  if (ht_.GetSize() > exec_ctx_->GetMemoryBudget()) {
+    Spill();
+  }
+}
 
-  if (!ht_.empty()) {
-    end_iter_ = ht_.begin()->second.end();
-    tuple_iter_ = end_iter_;  // set the tuple iterator to an invalid iterator for initialization
+void HashJoinExecutor::Spill() {
+  for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+    partitions_.emplace_back(MakePartition(0));
   }
+  ht_.ForEach([&](hash_t hash, const Tuple &tuple) { partitions_[PartitionOf(hash, 0)].left_->Append(tuple); });
+  ht_.Clear();
+  spilled_ = true;
+}
+
+HashJoinExecutor::Partition HashJoinExecutor::MakePartition(size_t level) {
+  BufferPoolManager *bpm = exec_ctx_->GetBufferPoolManager();
+  return Partition{std::make_unique<SpillFile>(bpm), std::make_unique<SpillFile>(bpm), level};
+}
+
+void HashJoinExecutor::Repartition(Partition *partition) {
+  size_t first = partitions_.size();
+  size_t level = partition->level_ + 1;
+  for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+    partitions_.emplace_back(MakePartition(level));
+  }
+  Tuple tuple;
+  while (partition->left_->Next(&tuple)) {
+    Value value = plan_->LeftJoinKeyExpression()->Evaluate(&tuple, plan_->GetLeftPlan()->OutputSchema());
+    partitions_[first + PartitionOf(HashUtil::HashValue(&value), level)].left_->Append(tuple);
+  }
+  while (partition->right_->Next(&tuple)) {
+    Value value = plan_->RightJoinKeyExpression()->Evaluate(&tuple, plan_->GetRightPlan()->OutputSchema());
+    partitions_[first + PartitionOf(HashUtil::HashValue(&value), level)].right_->Append(tuple);
+  }
+}
+
+bool HashJoinExecutor::NextPartition() {
+  ht_.Clear();
+  right_partition_.reset();
+  while (!partitions_.empty()) {
+    Partition partition = std::move(partitions_.back());
+    partitions_.pop_back();
+    if (partition.left_->GetNumTuples() == 0 || partition.right_->GetNumTuples() == 0) {
+      continue;
+    }
+    if (partition.left_->GetSize() > exec_ctx_->GetMemoryBudget() && partition.level_ + 1 < MAX_LEVELS) {
+      Repartition(&partition);
+      continue;
+    }
+    Tuple tuple;
+    while (partition.left_->Next(&tuple)) {
+      Value value = plan_->LeftJoinKeyExpression()->Evaluate(&tuple, plan_->GetLeftPlan()->OutputSchema());
+      ht_.Insert(HashUtil::HashValue(&value), value, std::move(tuple));
+    }
+    right_partition_ = std::move(partition.right_);
+    return true;
+  }
+  return false;
 }
 
 bool HashJoinExecutor::Next(Tuple *tuple, RID *rid) {
-  if (ht_.empty()) {
+  const Tuple *left_tuple;
+  if (!NextMatch(&left_tuple)) {
     return false;
   }
+  std::vector<Value> values;
+  JoinValues(*left_tuple, right_tuple_, &values);
+  *tuple = Tuple(values, plan_->OutputSchema());
+  return true;
+}
+
+bool HashJoinExecutor::NextBatch(VectorBatch *batch) {
+  batch->Reset(plan_->OutputSchema());
+  std::vector<Value> values;
+  const Tuple *left_tuple;
+  while (!batch->IsFull() && NextMatch(&left_tuple)) {
+    JoinValues(*left_tuple, right_tuple_, &values);
+    batch->AppendValues(values, RID());
+  }
+  return batch->NumSelected() > 0;
+}
 
-  bool found_target = false;
+bool HashJoinExecutor::ParallelBatches(const std::function<void(size_t, VectorBatch *)> &consume) {
+  size_t parallelism = exec_ctx_->GetParallelism();
+  if (parallelism <= 1 || spilled_) {
+    return false;
+  }
+  const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+  if (ht_.IsEmpty()) {
+    return true;
+  }
 
-  while (!found_target) {
-    while (tuple_iter_ == end_iter_) {
-      if (!right_executor_->Next(&right_tuple_, &right_rid_)) {
-        return false;
+  // The hash table is only read while probing, so the threads share it without synchronization.
+  std::vector<ColumnVector> right_keys(parallelism);
+  std::vector<VectorBatch> batches(parallelism);
+  for (auto &batch : batches) {
+    batch.Reset(plan_->OutputSchema());
+  }
+  bool parallel = right_executor_->ParallelBatches([&](size_t slot, VectorBatch *right_batch) {
+    plan_->RightJoinKeyExpression()->EvaluateBatch(*right_batch, right_schema, &right_keys[slot]);
+    VectorBatch *batch = &batches[slot];
+    std::vector<Value> values;
+    for (auto row : right_batch->GetSelection()) {
+      Value right_value = right_keys[slot].GetValue(row);
+      uint32_t entry = ht_.Find(HashUtil::HashValue(&right_value), right_value);
+      if (entry == JoinHashTable::NO_ENTRY) {
+        continue;
       }
-      right_value_ = plan_->RightJoinKeyExpression()->Evaluate(&right_tuple_, plan_->GetRightPlan()->OutputSchema());
-      hash_t hash_value = HashUtil::HashValue(&right_value_);
-      if (ht_.find(hash_value) != ht_.end()) {
-        tuple_iter_ = ht_[hash_value].begin();
-        end_iter_ = ht_[hash_value].end();
+      Tuple right_tuple = right_batch->GetTuple(row, right_schema);
+      for (; entry != JoinHashTable::NO_ENTRY; entry = ht_.Next(entry)) {
+        JoinValues(ht_.GetTuple(entry), right_tuple, &values);
+        batch->AppendValues(values, RID());
+        if (batch->IsFull()) {
+          consume(slot, batch);
+          batch->Reset(plan_->OutputSchema());
+        }
       }
     }
+  });
+  if (!parallel) {
+    return false;
+  }
+  // Hand out what is left of the batches of every slot.
+  for (size_t slot = 0; slot < parallelism; slot++) {
+    if (batches[slot].NumSelected() > 0) {
+      consume(slot, &batches[slot]);
+    }
+  }
+  return true;
+}
 
-    while (tuple_iter_ != end_iter_) {
-      Value left_value =
-          plan_->LeftJoinKeyExpression()->Evaluate(&(*tuple_iter_), plan_->GetLeftPlan()->OutputSchema());
-      if (left_value.CompareEquals(right_value_) == CmpBool::CmpTrue) {
-        found_target = true;
-        break;
+bool HashJoinExecutor::NextRightBatch() {
+  if (!spilled_) {
+    return right_executor_->NextBatch(&right_batch_);
+  }
+  const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+  right_batch_.Reset(right_schema);
+  Tuple tuple;
+  while (!right_batch_.IsFull()) {
+    if (right_partition_ != nullptr && right_partition_->Next(&tuple)) {
+      right_batch_.AppendTuple(tuple, RID(), right_schema);
+      continue;
+    }
+    // Only move on to the next pair of partitions once the rows of this one have been probed.
+    if (right_batch_.NumSelected() > 0 || !NextPartition()) {
+      break;
+    }
+  }
+  return right_batch_.NumSelected() > 0;
+}
+
+bool HashJoinExecutor::NextRightRow() {
+  const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+  match_ = JoinHashTable::NO_ENTRY;
+  if (!spilled_ && ht_.IsEmpty()) {
+    return false;
+  }
+  while (true) {
+    if (right_pos_ == right_batch_.NumSelected()) {
+      if (!NextRightBatch()) {
+        right_batch_.Reset(right_schema);
+        right_pos_ = 0;
+        return false;
       }
-      tuple_iter_++;
+      plan_->RightJoinKeyExpression()->EvaluateBatch(right_batch_, right_schema, &right_keys_);
+      right_pos_ = 0;
+    }
+    uint32_t row = right_batch_.GetSelection()[right_pos_++];
+    right_value_ = right_keys_.GetValue(row);
+    match_ = ht_.Find(HashUtil::HashValue(&right_value_), right_value_);
+    if (match_ != JoinHashTable::NO_ENTRY) {
+      // Only build a tuple for the rows that have a match.
+      right_tuple_ = right_batch_.GetTuple(row, right_schema);
+      return true;
     }
   }
+}
 
-  std::vector<Value> values;
-  for (auto &column : plan_->OutputSchema()->GetColumns()) {
-    values.emplace_back(column.GetExpr()->EvaluateJoin(&(*tuple_iter_), plan_->GetLeftPlan()->OutputSchema(),
-                                                       &right_tuple_, plan_->GetRightPlan()->OutputSchema()));
+bool HashJoinExecutor::NextMatch(const Tuple **left_tuple) {
+  if (match_ == JoinHashTable::NO_ENTRY && !NextRightRow()) {
+    return false;
   }
-  tuple_iter_++;
-  *tuple = Tuple(values, plan_->OutputSchema());
+  // All tuples of the chain have the key of the right row.
+  *left_tuple = &ht_.GetTuple(match_);
+  match_ = ht_.Next(match_);
   return true;
 }
 
+void HashJoinExecutor::JoinValues(const Tuple &left_tuple, const Tuple &right_tuple, std::vector<Value> *values) {
+  const Schema *left_schema = plan_->GetLeftPlan()->OutputSchema();
+  const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+  values->clear();
+  for (const auto &column : plan_->OutputSchema()->GetColumns()) {
+    values->emplace_back(column.GetExpr()->EvaluateJoin(&left_tuple, left_schema, &right_tuple, right_schema));
+  }
+}
+
 }  // namespace bustub
@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_bounds.cpp
+//
+// Identification: src/execution/index_bounds.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/index_bounds.h"
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+
+namespace bustub {
+
+bool IndexBoundsUtil::DeriveBounds(const std::vector<const AbstractExpression *> &conjuncts, uint32_t col_idx,
+                                   std::optional<IndexKeyBound> *lower, std::optional<IndexKeyBound> *upper) {
+  bool bounded = false;
+  for (const auto *conjunct : conjuncts) {
+    const auto *comparison = dynamic_cast<const ComparisonExpression *>(conjunct);
+    if (comparison == nullptr) {
+      continue;
+    }
+    // Find the column and the constant, and turn `const op col` around into `col op' const`.
+    const auto *column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0));
+    const auto *constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(1));
+    bool flipped = false;
+    if (column == nullptr || constant == nullptr) {
+      column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1));
+      constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(0));
+      flipped = true;
+    }
+    if (column == nullptr || constant == nullptr || column->GetTupleIdx() != 0 || column->GetColIdx() != col_idx) {
+      continue;
+    }
+    Value key = constant->Evaluate(nullptr, nullptr);
+    if (key.IsNull()) {
+      // A comparison with NULL holds for no tuple; the predicate takes care of it.
+      continue;
+    }
+
+    ComparisonType type = comparison->GetComparisonType();
+    if (flipped) {
+      switch (type) {
+        case ComparisonType::LessThan:
+          type = ComparisonType::GreaterThan;
+          break;
+        case ComparisonType::LessThanOrEqual:
+          type = ComparisonType::GreaterThanOrEqual;
+          break;
+        case ComparisonType::GreaterThan:
+          type = ComparisonType::LessThan;
+          break;
+        case ComparisonType::GreaterThanOrEqual:
+          type = ComparisonType::LessThanOrEqual;
+          break;
+        default:
+          break;
+      }
+    }
+    switch (type) {
+      case ComparisonType::Equal:
+        TightenLower(key, true, lower);
+        TightenUpper(key, true, upper);
+        break;
+      case ComparisonType::LessThan:
+        TightenUpper(key, false, upper);
+        break;
+      case ComparisonType::LessThanOrEqual:
+        TightenUpper(key, true, upper);
+        break;
+      case ComparisonType::GreaterThan:
+        TightenLower(key, false, lower);
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        TightenLower(key, true, lower);
+        break;
+      case ComparisonType::NotEqual:
+        continue;
+    }
+    bounded = true;
+  }
+  return bounded;
+}
+
+bool IndexBoundsUtil::IsAboveLower(const Value &key, const std::optional<IndexKeyBound> &lower) {
+  if (!lower.has_value()) {
+    return true;
+  }
+  if (key.IsNull()) {
+    return false;
+  }
+  return lower->inclusive_ ? key.CompareGreaterThanEquals(lower->key_) == CmpBool::CmpTrue
+                           : key.CompareGreaterThan(lower->key_) == CmpBool::CmpTrue;
+}
+
+bool IndexBoundsUtil::IsBelowUpper(const Value &key, const std::optional<IndexKeyBound> &upper) {
+  if (!upper.has_value()) {
+    return true;
+  }
+  if (key.IsNull()) {
+    return false;
+  }
+  return upper->inclusive_ ? key.CompareLessThanEquals(upper->key_) == CmpBool::CmpTrue
+                           : key.CompareLessThan(upper->key_) == CmpBool::CmpTrue;
+}
+
+void IndexBoundsUtil::TightenLower(const Value &key, bool inclusive, std::optional<IndexKeyBound> *lower) {
+  // Of two bounds on the same key, the exclusive one is the tighter.
+  if (!lower->has_value() || key.CompareGreaterThan((*lower)->key_) == CmpBool::CmpTrue ||
+      (!inclusive && key.CompareEquals((*lower)->key_) == CmpBool::CmpTrue)) {
+    *lower = IndexKeyBound{key, inclusive};
+  }
+}
+
+void IndexBoundsUtil::TightenUpper(const Value &key, bool inclusive, std::optional<IndexKeyBound> *upper) {
+  if (!upper->has_value() || key.CompareLessThan((*upper)->key_) == CmpBool::CmpTrue ||
+      (!inclusive && key.CompareEquals((*upper)->key_) == CmpBool::CmpTrue)) {
+    *upper = IndexKeyBound{key, inclusive};
+  }
+}
+
+}  // namespace bustub
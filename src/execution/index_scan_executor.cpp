@@ -6,17 +6,123 @@
 //
 // Identification: src/execution/index_scan_executor.cpp
 //
-// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
 #include "execution/executors/index_scan_executor.h"
 
+#include "execution/index_bounds.h"
+#include "storage/index/b_plus_tree_index.h"
+
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), table_iter_(nullptr, RID(INVALID_PAGE_ID, 0), nullptr) {}
+
+void IndexScanExecutor::Init() {
+  Catalog *catalog = exec_ctx_->GetCatalog();
+  index_info_ = catalog->GetIndex(plan_->GetIndexOid());
+  table_info_ = catalog->GetTable(index_info_->table_name_);
+  key_column_ = index_info_->index_->GetKeyAttrs()[0];
+  rids_.clear();
+  rid_pos_ = 0;
+  scan_table_ = !ScanTree<4>() && !ScanTree<8>() && !ScanTree<16>() && !ScanTree<32>() && !ScanTree<64>() &&
+                !ScanPoint();
+  if (scan_table_) {
+    table_iter_ = table_info_->table_->Begin(exec_ctx_->GetTransaction());
+  }
+}
+
+template <size_t N>
+bool IndexScanExecutor::ScanTree() {
+  auto *tree = dynamic_cast<BPlusTreeIndex<GenericKey<N>, RID, GenericComparator<N>> *>(index_info_->index_.get());
+  if (tree == nullptr) {
+    return false;
+  }
+  Schema *key_schema = tree->GetKeySchema();
+  const auto &lower = plan_->GetLowerBound();
+  const auto &upper = plan_->GetUpperBound();
+
+  // Seek to the first key whose leading column reaches the lower bound: the other columns of the key are the least
+  // values of their types.
+  auto iter = tree->GetBeginIterator();
+  if (lower.has_value()) {
+    std::vector<Value> values;
+    values.emplace_back(lower->key_.CastAs(key_schema->GetColumn(0).GetType()));
+    for (uint32_t i = 1; i < key_schema->GetColumnCount(); i++) {
+      values.emplace_back(Type::GetMinValue(key_schema->GetColumn(i).GetType()));
+    }
+    GenericKey<N> key;
+    key.SetFromKey(Tuple(values, key_schema));
+    iter = tree->GetBeginIterator(key);
+  }
+  for (; !iter.IsEnd(); ++iter) {
+    Value leading = (*iter).first.ToValue(key_schema, 0);
+    if (!IndexBoundsUtil::IsAboveLower(leading, lower)) {
+      // Only keys equal to an exclusive lower bound come before the range.
+      continue;
+    }
+    if (!IndexBoundsUtil::IsBelowUpper(leading, upper)) {
+      break;
+    }
+    rids_.push_back((*iter).second);
+  }
+  return true;
+}
+
+bool IndexScanExecutor::ScanPoint() {
+  const auto &lower = plan_->GetLowerBound();
+  const auto &upper = plan_->GetUpperBound();
+  const Schema &key_schema = index_info_->key_schema_;
+  if (key_schema.GetColumnCount() != 1 || !lower.has_value() || !upper.has_value() || !lower->inclusive_ ||
+      !upper->inclusive_ || lower->key_.CompareEquals(upper->key_) != CmpBool::CmpTrue) {
+    return false;
+  }
+  Tuple key({lower->key_.CastAs(key_schema.GetColumn(0).GetType())}, &key_schema);
+  index_info_->index_->ScanKey(key, &rids_, exec_ctx_->GetTransaction());
+  return true;
+}
+
+bool IndexScanExecutor::Matches(const Tuple &tuple) const {
+  const Schema *schema = &table_info_->schema_;
+  Value key = tuple.GetValue(schema, key_column_);
+  if (!IndexBoundsUtil::IsAboveLower(key, plan_->GetLowerBound()) ||
+      !IndexBoundsUtil::IsBelowUpper(key, plan_->GetUpperBound())) {
+    return false;
+  }
+  return plan_->GetPredicate() == nullptr || plan_->GetPredicate()->Evaluate(&tuple, schema).GetAs<bool>();
+}
 
-void IndexScanExecutor::Init() {}
+bool IndexScanExecutor::Next(Tuple *tuple, RID *rid) {
+  if (scan_table_) {
+    // The tuples of the iterator are only valid until it moves on, so the output is built before it does.
+    for (; table_iter_ != table_info_->table_->End(); ++table_iter_) {
+      if (Matches(*table_iter_)) {
+        MakeOutput(*table_iter_, tuple, rid);
+        ++table_iter_;
+        return true;
+      }
+    }
+    return false;
+  }
+  Tuple table_tuple;
+  while (rid_pos_ < rids_.size()) {
+    // Skip tuples that were deleted, or could not be locked.
+    if (table_info_->table_->GetTuple(rids_[rid_pos_++], &table_tuple, exec_ctx_->GetTransaction()) &&
+        Matches(table_tuple)) {
+      MakeOutput(table_tuple, tuple, rid);
+      return true;
+    }
+  }
+  return false;
+}
 
-bool IndexScanExecutor::Next(Tuple *tuple, RID *rid) { return false; }
+void IndexScanExecutor::MakeOutput(const Tuple &table_tuple, Tuple *tuple, RID *rid) const {
+  std::vector<Value> values;
+  for (const auto &column : plan_->OutputSchema()->GetColumns()) {
+    values.emplace_back(column.GetExpr()->Evaluate(&table_tuple, &table_info_->schema_));
+  }
+  *tuple = Tuple(values, plan_->OutputSchema());
+  *rid = table_tuple.GetRid();
+}
 
 }  // namespace bustub
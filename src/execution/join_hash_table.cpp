@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table.cpp
+//
+// Identification: src/execution/join_hash_table.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/join_hash_table.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+void JoinHashTable::Insert(hash_t hash, const Value &key, Tuple &&tuple) {
+  if (key.IsNull()) {
+    return;
+  }
+  auto entry = static_cast<uint32_t>(tuples_.size());
+  size_ += tuple.GetLength();
+  tuples_.emplace_back(std::move(tuple));
+  next_.emplace_back(NO_ENTRY);
+
+  // Keep the table at most half full, so that probe sequences stay short.
+  if ((keys_.size() + 1) * 2 > tags_.size()) {
+    Grow();
+  }
+  hash_t mixed = Mix(hash);
+  uint8_t tag = Tag(mixed);
+  size_t mask = tags_.size() - 1;
+  for (size_t i = mixed & mask;; i = (i + 1) & mask) {
+    if (tags_[i] == EMPTY) {
+      tags_[i] = tag;
+      slots_[i] = Slot{hash, static_cast<uint32_t>(keys_.size()), entry};
+      keys_.emplace_back(key);
+      return;
+    }
+    if (tags_[i] == tag && slots_[i].hash_ == hash && keys_[slots_[i].key_].CompareEquals(key) == CmpBool::CmpTrue) {
+      // Prepend to the chain of the key.
+      next_[entry] = slots_[i].head_;
+      slots_[i].head_ = entry;
+      return;
+    }
+  }
+}
+
+uint32_t JoinHashTable::Find(hash_t hash, const Value &key) const {
+  if (tags_.empty()) {
+    return NO_ENTRY;
+  }
+  hash_t mixed = Mix(hash);
+  uint8_t tag = Tag(mixed);
+  size_t mask = tags_.size() - 1;
+  for (size_t i = mixed & mask; tags_[i] != EMPTY; i = (i + 1) & mask) {
+    if (tags_[i] == tag && slots_[i].hash_ == hash && keys_[slots_[i].key_].CompareEquals(key) == CmpBool::CmpTrue) {
+      return slots_[i].head_;
+    }
+  }
+  return NO_ENTRY;
+}
+
+void JoinHashTable::ForEach(const std::function<void(hash_t, const Tuple &)> &visit) const {
+  for (size_t i = 0; i < tags_.size(); i++) {
+    if (tags_[i] == EMPTY) {
+      continue;
+    }
+    for (uint32_t entry = slots_[i].head_; entry != NO_ENTRY; entry = next_[entry]) {
+      visit(slots_[i].hash_, tuples_[entry]);
+    }
+  }
+}
+
+void JoinHashTable::Clear() {
+  tags_.clear();
+  slots_.clear();
+  keys_.clear();
+  tuples_.clear();
+  next_.clear();
+  size_ = 0;
+}
+
+void JoinHashTable::Grow() {
+  std::vector<uint8_t> tags(std::max<size_t>(tags_.size() * 2, 16), EMPTY);
+  std::vector<Slot> slots(tags.size());
+  tags.swap(tags_);
+  slots.swap(slots_);
+  for (size_t i = 0; i < tags.size(); i++) {
+    if (tags[i] != EMPTY) {
+      Place(slots[i]);
+    }
+  }
+}
+
+void JoinHashTable::Place(const Slot &slot) {
+  hash_t mixed = Mix(slot.hash_);
+  size_t mask = tags_.size() - 1;
+  size_t i = mixed & mask;
+  while (tags_[i] != EMPTY) {
+    i = (i + 1) & mask;
+  }
+  tags_[i] = Tag(mixed);
+  slots_[i] = slot;
+}
+
+}  // namespace bustub
@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.cpp
+//
+// Identification: src/execution/merge_join_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/merge_join_executor.h"
+
+#include "execution/expressions/abstract_expression.h"
+
+namespace bustub {
+
+MergeJoinExecutor::MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&left_child,
+                                     std::unique_ptr<AbstractExecutor> &&right_child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)) {}
+
+void MergeJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  auto open = [this](Cursor *cursor, AbstractExecutor *child, const AbstractExpression *key_expr) {
+    cursor->child_ = child;
+    cursor->key_expr_ = key_expr;
+    cursor->batch_ = VectorBatch();
+    cursor->pos_ = 0;
+    cursor->done_ = false;
+    Fill(cursor);
+  };
+  open(&left_, left_executor_.get(), plan_->LeftJoinKeyExpression());
+  open(&right_, right_executor_.get(), plan_->RightJoinKeyExpression());
+  right_run_.clear();
+  run_pos_ = 0;
+  left_matched_ = false;
+}
+
+bool MergeJoinExecutor::Fill(Cursor *cursor) {
+  while (!cursor->done_ && cursor->pos_ >= cursor->batch_.NumSelected()) {
+    if (!cursor->child_->NextBatch(&cursor->batch_)) {
+      cursor->done_ = true;
+      break;
+    }
+    cursor->key_expr_->EvaluateBatch(cursor->batch_, cursor->child_->GetOutputSchema(), &cursor->keys_);
+    cursor->pos_ = 0;
+  }
+  return !cursor->done_;
+}
+
+const Tuple *MergeJoinExecutor::NextMatch() {
+  while (true) {
+    if (left_matched_) {
+      if (run_pos_ < right_run_.size()) {
+        return &right_run_[run_pos_++];
+      }
+      left_matched_ = false;
+      Advance(&left_);
+    }
+    if (left_.done_) {
+      return nullptr;
+    }
+    Value left_key = Key(left_);
+    if (left_key.IsNull()) {
+      Advance(&left_);
+      continue;
+    }
+
+    // A left key that differs from the key of the run is larger: gather the run of right tuples with that key,
+    // skipping the right tuples with smaller keys.
+    if (right_run_.empty() || left_key.CompareEquals(run_key_) != CmpBool::CmpTrue) {
+      right_run_.clear();
+      while (!right_.done_) {
+        Value right_key = Key(right_);
+        if (!right_key.IsNull()) {
+          if (right_key.CompareEquals(left_key) == CmpBool::CmpTrue) {
+            right_run_.emplace_back(GetTuple(right_));
+          } else if (right_key.CompareGreaterThan(left_key) == CmpBool::CmpTrue) {
+            break;
+          }
+        }
+        Advance(&right_);
+      }
+      if (right_run_.empty()) {
+        if (right_.done_) {
+          // No right tuples are left to join with this or any larger left key.
+          return nullptr;
+        }
+        Advance(&left_);
+        continue;
+      }
+      run_key_ = left_key;
+    }
+    left_tuple_ = GetTuple(left_);
+    run_pos_ = 0;
+    left_matched_ = true;
+  }
+}
+
+bool MergeJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  const Tuple *right_tuple = NextMatch();
+  if (right_tuple == nullptr) {
+    return false;
+  }
+  std::vector<Value> values;
+  JoinValues(left_tuple_, *right_tuple, &values);
+  *tuple = Tuple(values, plan_->OutputSchema());
+  return true;
+}
+
+bool MergeJoinExecutor::NextBatch(VectorBatch *batch) {
+  batch->Reset(plan_->OutputSchema());
+  std::vector<Value> values;
+  while (!batch->IsFull()) {
+    const Tuple *right_tuple = NextMatch();
+    if (right_tuple == nullptr) {
+      break;
+    }
+    JoinValues(left_tuple_, *right_tuple, &values);
+    batch->AppendValues(values, RID());
+  }
+  return batch->NumSelected() > 0;
+}
+
+void MergeJoinExecutor::JoinValues(const Tuple &left_tuple, const Tuple &right_tuple, std::vector<Value> *values) {
+  const Schema *left_schema = plan_->GetLeftPlan()->OutputSchema();
+  const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+  values->clear();
+  for (const auto &column : plan_->OutputSchema()->GetColumns()) {
+    values->emplace_back(column.GetExpr()->EvaluateJoin(&left_tuple, left_schema, &right_tuple, right_schema));
+  }
+}
+
+}  // namespace bustub
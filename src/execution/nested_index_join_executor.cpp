@@ -12,14 +12,132 @@
 
 #include "execution/executors/nested_index_join_executor.h"
 
+#include <algorithm>
+
+#include "common/exception.h"
+#include "execution/sort_key.h"
+
 namespace bustub {
 
 NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const NestedIndexJoinPlanNode *plan,
                                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void NestIndexJoinExecutor::Init() {
+  child_executor_->Init();
+  Catalog *catalog = exec_ctx_->GetCatalog();
+  inner_table_info_ = catalog->GetTable(plan_->GetInnerTableOid());
+  index_info_ = catalog->GetIndex(plan_->GetIndexName(), inner_table_info_->name_);
+  output_.clear();
+  output_pos_ = 0;
+}
+
+bool NestIndexJoinExecutor::JoinNextBatch() {
+  output_.clear();
+  output_pos_ = 0;
+  if (!child_executor_->NextBatch(&outer_batch_)) {
+    return false;
+  }
+  const Schema *outer_schema = child_executor_->GetOutputSchema();
+  const Schema *inner_schema = &inner_table_info_->schema_;
+  Transaction *txn = exec_ctx_->GetTransaction();
+
+  // Sort the probes by key, so that the index is probed in key order, and only once for equal keys. NULL keys match
+  // nothing.
+  plan_->Predicate()->GetChildAt(0)->EvaluateBatch(outer_batch_, outer_schema, &probe_keys_);
+  std::vector<Probe> probes;
+  for (auto row : outer_batch_.GetSelection()) {
+    Value key = probe_keys_.GetValue(row);
+    if (key.IsNull()) {
+      continue;
+    }
+    Probe probe{"", key, row};
+    SortKeyUtil::AppendValue(key, OrderByType::Asc, &probe.sort_key_);
+    probes.emplace_back(std::move(probe));
+  }
+  std::sort(probes.begin(), probes.end(),
+            [](const Probe &left, const Probe &right) { return left.sort_key_ < right.sort_key_; });
+
+  std::vector<std::pair<uint32_t, RID>> matches;
+  std::vector<RID> rids;
+  for (size_t i = 0; i < probes.size();) {
+    rids.clear();
+    index_info_->index_->ScanKey(Tuple({probes[i].key_}, &index_info_->key_schema_), &rids, txn);
+    size_t end = i;
+    for (; end < probes.size() && probes[end].sort_key_ == probes[i].sort_key_; end++) {
+      for (const auto &rid : rids) {
+        matches.emplace_back(probes[end].row_, rid);
+      }
+    }
+    i = end;
+  }
+
+  // Fetch each inner tuple once, in RID order, so that each page is fetched once for all its tuples.
+  auto rid_less = [](const RID &left, const RID &right) {
+    return left.GetPageId() < right.GetPageId() ||
+           (left.GetPageId() == right.GetPageId() && left.GetSlotNum() < right.GetSlotNum());
+  };
+  rids.clear();
+  for (const auto &match : matches) {
+    rids.push_back(match.second);
+  }
+  std::sort(rids.begin(), rids.end(), rid_less);
+  rids.erase(std::unique(rids.begin(), rids.end()), rids.end());
+  std::vector<Tuple> inner_tuples;
+  if (!inner_table_info_->table_->GetTuples(rids, &inner_tuples, txn)) {
+    // The transaction is already aborted; joining the tuples that could be read would drop rows silently.
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "no free frame to read the inner tuples");
+  }
+
+  Tuple outer_tuple;
+  uint32_t outer_row = 0;
+  bool have_outer = false;
+  for (const auto &[row, rid] : matches) {
+    auto inner = std::lower_bound(inner_tuples.begin(), inner_tuples.end(), rid,
+                                  [&](const Tuple &tuple, const RID &key) { return rid_less(tuple.GetRid(), key); });
+    if (inner == inner_tuples.end() || !(inner->GetRid() == rid)) {
+      // The tuple was deleted, or could not be locked.
+      continue;
+    }
+    if (!have_outer || outer_row != row) {
+      outer_tuple = outer_batch_.GetTuple(row, outer_schema);
+      outer_row = row;
+      have_outer = true;
+    }
+    if (!plan_->Predicate()->EvaluateJoin(&outer_tuple, outer_schema, &*inner, inner_schema).GetAs<bool>()) {
+      continue;
+    }
+    std::vector<Value> values;
+    for (const auto &column : plan_->OutputSchema()->GetColumns()) {
+      values.emplace_back(column.GetExpr()->EvaluateJoin(&outer_tuple, outer_schema, &*inner, inner_schema));
+    }
+    output_.emplace_back(std::move(values));
+  }
+  return true;
+}
 
-void NestIndexJoinExecutor::Init() {}
+bool NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  while (output_pos_ == output_.size()) {
+    if (!JoinNextBatch()) {
+      return false;
+    }
+  }
+  *tuple = Tuple(output_[output_pos_++], plan_->OutputSchema());
+  return true;
+}
 
-bool NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) { return false; }
+bool NestIndexJoinExecutor::NextBatch(VectorBatch *batch) {
+  batch->Reset(plan_->OutputSchema());
+  while (!batch->IsFull()) {
+    if (output_pos_ == output_.size() && !JoinNextBatch()) {
+      break;
+    }
+    // A batch of the outer side can join with more rows than fit in a batch, or with none.
+    while (!batch->IsFull() && output_pos_ < output_.size()) {
+      batch->AppendValues(output_[output_pos_++], RID());
+    }
+  }
+  return batch->NumSelected() > 0;
+}
 
 }  // namespace bustub
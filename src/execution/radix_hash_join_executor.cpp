@@ -0,0 +1,224 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// radix_hash_join_executor.cpp
+//
+// Identification: src/execution/radix_hash_join_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/radix_hash_join_executor.h"
+
+#include "execution/expressions/abstract_expression.h"
+
+namespace bustub {
+
+RadixHashJoinExecutor::RadixHashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
+                                             std::unique_ptr<AbstractExecutor> &&left_child,
+                                             std::unique_ptr<AbstractExecutor> &&right_child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)) {}
+
+void RadixHashJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+
+  std::vector<std::vector<Row>> left_rows;
+  std::vector<std::vector<Row>> right_rows;
+  Gather(left_executor_.get(), plan_->LeftJoinKeyExpression(), plan_->GetLeftPlan()->OutputSchema(), &left_rows);
+  Gather(right_executor_.get(), plan_->RightJoinKeyExpression(), plan_->GetRightPlan()->OutputSchema(), &right_rows);
+
+  // Pick the number of partitions from the size of the left side, with enough of them to keep every thread busy.
+  size_t left_size = 0;
+  for (const auto &rows : left_rows) {
+    for (const auto &row : rows) {
+      left_size += sizeof(Row) + row.tuple_.GetLength();
+    }
+  }
+  size_t parallelism = exec_ctx_->GetParallelism();
+  radix_bits_ = 0;
+  while (radix_bits_ < MAX_RADIX_BITS) {
+    bool too_large = (left_size >> radix_bits_) > PARTITION_SIZE;
+    bool too_few = parallelism > 1 && (static_cast<size_t>(1) << radix_bits_) < 4 * parallelism;
+    if (!too_large && !too_few) {
+      break;
+    }
+    radix_bits_++;
+  }
+  num_partitions_ = static_cast<size_t>(1) << radix_bits_;
+
+  // Scatter the rows each slot read into partitions of that slot, one task per side and slot.
+  size_t num_slots = left_rows.size();
+  left_partitions_.assign(num_slots, std::vector<std::vector<Row>>(num_partitions_));
+  right_partitions_.assign(right_rows.size(), std::vector<std::vector<Row>>(num_partitions_));
+  auto scatter = [&](std::vector<Row> *rows, std::vector<std::vector<Row>> *partitions) {
+    for (auto &row : *rows) {
+      (*partitions)[PartitionOf(row.hash_)].emplace_back(std::move(row));
+    }
+    rows->clear();
+    rows->shrink_to_fit();
+  };
+  exec_ctx_->GetTaskScheduler()->Run(num_slots + right_rows.size(), parallelism, [&](size_t task, size_t slot) {
+    if (task < num_slots) {
+      scatter(&left_rows[task], &left_partitions_[task]);
+    } else {
+      scatter(&right_rows[task - num_slots], &right_partitions_[task - num_slots]);
+    }
+  });
+
+  partition_ = 0;
+  built_ = false;
+  match_ = JoinHashTable::NO_ENTRY;
+}
+
+void RadixHashJoinExecutor::Gather(AbstractExecutor *child, const AbstractExpression *key, const Schema *schema,
+                                   std::vector<std::vector<Row>> *rows) {
+  size_t parallelism = exec_ctx_->GetParallelism();
+  std::vector<ColumnVector> keys(parallelism);
+  rows->assign(parallelism, {});
+  auto gather = [&](size_t slot, const VectorBatch &batch) {
+    key->EvaluateBatch(batch, schema, &keys[slot]);
+    for (auto row : batch.GetSelection()) {
+      Value value = keys[slot].GetValue(row);
+      if (!value.IsNull()) {
+        (*rows)[slot].push_back(Row{HashUtil::HashValue(&value), value, batch.GetTuple(row, schema)});
+      }
+    }
+  };
+  if (child->ParallelBatches([&](size_t slot, VectorBatch *batch) { gather(slot, *batch); })) {
+    return;
+  }
+  VectorBatch batch;
+  while (child->NextBatch(&batch)) {
+    gather(0, batch);
+  }
+}
+
+void RadixHashJoinExecutor::Build(size_t partition, JoinHashTable *ht) {
+  ht->Clear();
+  for (auto &partitions : left_partitions_) {
+    for (auto &row : partitions[partition]) {
+      ht->Insert(row.hash_, row.key_, std::move(row.tuple_));
+    }
+    partitions[partition].clear();
+  }
+}
+
+bool RadixHashJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  const Tuple *left_tuple;
+  if (!NextMatch(&left_tuple)) {
+    return false;
+  }
+  std::vector<Value> values;
+  JoinValues(*left_tuple, right_row_->tuple_, &values);
+  *tuple = Tuple(values, plan_->OutputSchema());
+  return true;
+}
+
+bool RadixHashJoinExecutor::NextBatch(VectorBatch *batch) {
+  batch->Reset(plan_->OutputSchema());
+  std::vector<Value> values;
+  const Tuple *left_tuple;
+  while (!batch->IsFull() && NextMatch(&left_tuple)) {
+    JoinValues(*left_tuple, right_row_->tuple_, &values);
+    batch->AppendValues(values, RID());
+  }
+  return batch->NumSelected() > 0;
+}
+
+bool RadixHashJoinExecutor::ParallelBatches(const std::function<void(size_t, VectorBatch *)> &consume) {
+  size_t parallelism = exec_ctx_->GetParallelism();
+  if (parallelism <= 1) {
+    return false;
+  }
+
+  // Each slot joins whole pairs of partitions with a hash table of its own, so the tasks share nothing.
+  std::vector<JoinHashTable> hts(parallelism);
+  std::vector<VectorBatch> batches(parallelism);
+  for (auto &batch : batches) {
+    batch.Reset(plan_->OutputSchema());
+  }
+  exec_ctx_->GetTaskScheduler()->Run(num_partitions_, parallelism, [&](size_t partition, size_t slot) {
+    JoinHashTable *ht = &hts[slot];
+    Build(partition, ht);
+    if (ht->IsEmpty()) {
+      return;
+    }
+    VectorBatch *batch = &batches[slot];
+    std::vector<Value> values;
+    for (const auto &partitions : right_partitions_) {
+      for (const auto &row : partitions[partition]) {
+        uint32_t entry = ht->Find(row.hash_, row.key_);
+        for (; entry != JoinHashTable::NO_ENTRY; entry = ht->Next(entry)) {
+          JoinValues(ht->GetTuple(entry), row.tuple_, &values);
+          batch->AppendValues(values, RID());
+          if (batch->IsFull()) {
+            consume(slot, batch);
+            batch->Reset(plan_->OutputSchema());
+          }
+        }
+      }
+    }
+  });
+  // Hand out what is left of the batches of every slot.
+  for (size_t slot = 0; slot < parallelism; slot++) {
+    if (batches[slot].NumSelected() > 0) {
+      consume(slot, &batches[slot]);
+    }
+  }
+  return true;
+}
+
+bool RadixHashJoinExecutor::NextRightRow() {
+  while (partition_ < num_partitions_) {
+    if (!built_) {
+      Build(partition_, &ht_);
+      built_ = true;
+      right_slot_ = 0;
+      right_pos_ = 0;
+    }
+    if (right_slot_ == right_partitions_.size()) {
+      // The right rows of this partition are done; move on to the next one.
+      partition_++;
+      built_ = false;
+      continue;
+    }
+    const auto &rows = right_partitions_[right_slot_][partition_];
+    if (right_pos_ == rows.size() || ht_.IsEmpty()) {
+      right_slot_++;
+      right_pos_ = 0;
+      continue;
+    }
+    right_row_ = &rows[right_pos_++];
+    match_ = ht_.Find(right_row_->hash_, right_row_->key_);
+    if (match_ != JoinHashTable::NO_ENTRY) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RadixHashJoinExecutor::NextMatch(const Tuple **left_tuple) {
+  if (match_ == JoinHashTable::NO_ENTRY && !NextRightRow()) {
+    return false;
+  }
+  *left_tuple = &ht_.GetTuple(match_);
+  match_ = ht_.Next(match_);
+  return true;
+}
+
+void RadixHashJoinExecutor::JoinValues(const Tuple &left_tuple, const Tuple &right_tuple, std::vector<Value> *values) {
+  const Schema *left_schema = plan_->GetLeftPlan()->OutputSchema();
+  const Schema *right_schema = plan_->GetRightPlan()->OutputSchema();
+  values->clear();
+  for (const auto &column : plan_->OutputSchema()->GetColumns()) {
+    values->emplace_back(column.GetExpr()->EvaluateJoin(&left_tuple, left_schema, &right_tuple, right_schema));
+  }
+}
+
+}  // namespace bustub
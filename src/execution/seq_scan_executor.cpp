@@ -20,13 +20,14 @@ SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNod
 void SeqScanExecutor::Init() {
   const auto table_oid = plan_->GetTableOid();
   table_info_ = exec_ctx_->GetCatalog()->GetTable(table_oid);
-  table_iter_ = table_info_->table_->Begin(exec_ctx_->GetTransaction());
+  strategy_ = std::make_unique<BufferAccessStrategy>(SCAN_RING_SIZE);
+  table_iter_ = table_info_->table_->Begin(exec_ctx_->GetTransaction(), strategy_.get());
 }
 
 bool SeqScanExecutor::Next(Tuple *tuple, RID *rid) {
   while (table_iter_ != table_info_->table_->End() && plan_->GetPredicate() != nullptr &&
          !plan_->GetPredicate()->Evaluate(&(*table_iter_), &table_info_->schema_).GetAs<bool>()) {
-    table_iter_++;
+    ++table_iter_;
   }
 
   if (table_iter_ == table_info_->table_->End()) {
@@ -58,8 +59,91 @@ bool SeqScanExecutor::Next(Tuple *tuple, RID *rid) {
 
   *tuple = Tuple(values, plan_->OutputSchema());
   *rid = table_iter_->GetRid();
-  table_iter_++;
+  ++table_iter_;
   return true;
 }
 
+bool SeqScanExecutor::NextBatch(VectorBatch *batch) {
+  return ProduceBatch(&table_iter_, table_info_->table_->End(), &scan_batch_, batch);
+}
+
+bool SeqScanExecutor::ParallelBatches(const std::function<void(size_t, VectorBatch *)> &consume) {
+  size_t parallelism = exec_ctx_->GetParallelism();
+  if (parallelism <= 1) {
+    return false;
+  }
+
+  // Each slot scans its morsels with its own buffer access strategy and batches.
+  struct Slot {
+    std::unique_ptr<BufferAccessStrategy> strategy_;
+    VectorBatch scan_batch_;
+    VectorBatch batch_;
+  };
+  std::vector<Slot> slots(parallelism);
+  TableHeap *table = table_info_->table_.get();
+  const std::vector<TableHeap::Morsel> morsels = table->GetMorsels(MORSEL_SIZE);
+  const TableIterator end = table->End();
+  exec_ctx_->GetTaskScheduler()->Run(morsels.size(), parallelism, [&](size_t task, size_t slot) {
+    Slot &state = slots[slot];
+    if (state.strategy_ == nullptr) {
+      state.strategy_ = std::make_unique<BufferAccessStrategy>(SCAN_RING_SIZE);
+    }
+    TableIterator iter = table->Begin(morsels[task], exec_ctx_->GetTransaction(), state.strategy_.get());
+    while (ProduceBatch(&iter, end, &state.scan_batch_, &state.batch_)) {
+      consume(slot, &state.batch_);
+    }
+  });
+  return true;
+}
+
+bool SeqScanExecutor::ProduceBatch(TableIterator *iter, const TableIterator &end, VectorBatch *scan_batch,
+                                   VectorBatch *batch) {
+  const Schema *schema = &table_info_->schema_;
+  while (*iter != end) {
+    scan_batch->Reset(schema);
+    for (; !scan_batch->IsFull() && *iter != end; ++*iter) {
+      scan_batch->AppendTuple(**iter, (*iter)->GetRid(), schema);
+    }
+    if (plan_->GetPredicate() != nullptr) {
+      plan_->GetPredicate()->FilterBatch(scan_batch, schema);
+    }
+    if (scan_batch->NumSelected() == 0) {
+      continue;
+    }
+
+    auto txn = exec_ctx_->GetTransaction();
+    auto isolation_level = txn->GetIsolationLevel();
+    auto lock_manager = exec_ctx_->GetLockManager();
+    const auto &rids = scan_batch->GetRids();
+    if (lock_manager != nullptr && isolation_level != IsolationLevel::READ_UNCOMMITTED) {
+      std::scoped_lock lock(lock_latch_);
+      for (auto row : scan_batch->GetSelection()) {
+        if (!txn->IsSharedLocked(rids[row]) && !txn->IsExclusiveLocked(rids[row]) &&
+            !lock_manager->LockShared(txn, rids[row])) {
+          return false;
+        }
+      }
+    }
+
+    batch->Reset(plan_->OutputSchema());
+    const auto &columns = plan_->OutputSchema()->GetColumns();
+    for (uint32_t i = 0; i < columns.size(); i++) {
+      columns[i].GetExpr()->EvaluateBatch(*scan_batch, schema, &batch->GetColumn(i));
+    }
+    batch->GetRids() = rids;
+    batch->GetSelection() = scan_batch->GetSelection();
+
+    if (lock_manager != nullptr && isolation_level == IsolationLevel::READ_COMMITTED) {
+      std::scoped_lock lock(lock_latch_);
+      for (auto row : scan_batch->GetSelection()) {
+        if (!lock_manager->Unlock(txn, rids[row])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
 }  // namespace bustub
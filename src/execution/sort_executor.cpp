@@ -0,0 +1,159 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_executor.cpp
+//
+// Identification: src/execution/sort_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/sort_executor.h"
+
+#include <algorithm>
+
+#include "execution/sort_key.h"
+
+namespace bustub {
+
+SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void SortExecutor::Init() {
+  child_executor_->Init();
+  entries_.clear();
+  size_ = 0;
+  pos_ = 0;
+  runs_.clear();
+  heads_.clear();
+  heap_.clear();
+
+  // Evaluate the ORDER BY keys over whole batches, and only encode them row by row.
+  const Schema *child_schema = child_executor_->GetOutputSchema();
+  const auto &order_bys = plan_->GetOrderBys();
+  std::vector<ColumnVector> key_columns(order_bys.size());
+  VectorBatch batch;
+  while (child_executor_->NextBatch(&batch)) {
+    for (uint32_t i = 0; i < order_bys.size(); i++) {
+      order_bys[i].second->EvaluateBatch(batch, child_schema, &key_columns[i]);
+    }
+    for (auto row : batch.GetSelection()) {
+      Entry entry{"", batch.GetTuple(row, child_schema)};
+      for (uint32_t i = 0; i < order_bys.size(); i++) {
+        SortKeyUtil::AppendValue(key_columns[i].GetValue(row), order_bys[i].first, &entry.key_);
+      }
+      size_ += sizeof(Entry) + entry.key_.size() + entry.tuple_.GetLength();
+      entries_.emplace_back(std::move(entry));
+      if (size_ > exec_ctx_->GetMemoryBudget()) {
+        WriteRun();
+      }
+    }
+  }
+
+  if (runs_.empty()) {
+    SortEntries();
+    return;
+  }
+  if (!entries_.empty()) {
+    WriteRun();
+  }
+  // Merge the runs into fewer, longer ones until they can all be merged at once. The merged runs are the first ones,
+  // and their merge takes their place, so that equal keys stay in order.
+  while (runs_.size() > MERGE_FAN_IN) {
+    StartMerge(MERGE_FAN_IN);
+    auto run = std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager());
+    Tuple tuple;
+    while (NextMerged(&tuple)) {
+      run->Append(tuple);
+    }
+    runs_.erase(runs_.begin(), runs_.begin() + MERGE_FAN_IN);
+    runs_.insert(runs_.begin(), std::move(run));
+  }
+  StartMerge(runs_.size());
+}
+
+void SortExecutor::SortEntries() {
+  std::stable_sort(entries_.begin(), entries_.end(),
+                   [](const Entry &left, const Entry &right) { return left.key_ < right.key_; });
+}
+
+void SortExecutor::WriteRun() {
+  SortEntries();
+  auto run = std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager());
+  for (const auto &entry : entries_) {
+    run->Append(entry.tuple_);
+  }
+  runs_.emplace_back(std::move(run));
+  entries_.clear();
+  size_ = 0;
+}
+
+void SortExecutor::StartMerge(size_t num_runs) {
+  const Schema *schema = child_executor_->GetOutputSchema();
+  heads_.assign(num_runs, Entry{});
+  heap_.clear();
+  for (size_t i = 0; i < num_runs; i++) {
+    runs_[i]->Rewind();
+    if (runs_[i]->Next(&heads_[i].tuple_)) {
+      SortKeyUtil::MakeKey(heads_[i].tuple_, schema, plan_->GetOrderBys(), &heads_[i].key_);
+      heap_.push_back(i);
+    }
+  }
+  std::make_heap(heap_.begin(), heap_.end(), [this](size_t left, size_t right) { return MergesAfter(left, right); });
+}
+
+bool SortExecutor::MergesAfter(size_t left, size_t right) const {
+  int cmp = heads_[left].key_.compare(heads_[right].key_);
+  return cmp > 0 || (cmp == 0 && left > right);
+}
+
+bool SortExecutor::NextMerged(Tuple *tuple) {
+  if (heap_.empty()) {
+    return false;
+  }
+  auto greater = [this](size_t left, size_t right) { return MergesAfter(left, right); };
+  std::pop_heap(heap_.begin(), heap_.end(), greater);
+  size_t run = heap_.back();
+  *tuple = std::move(heads_[run].tuple_);
+  if (runs_[run]->Next(&heads_[run].tuple_)) {
+    SortKeyUtil::MakeKey(heads_[run].tuple_, child_executor_->GetOutputSchema(), plan_->GetOrderBys(),
+                         &heads_[run].key_);
+    std::push_heap(heap_.begin(), heap_.end(), greater);
+  } else {
+    heap_.pop_back();
+  }
+  return true;
+}
+
+bool SortExecutor::NextTuple(Tuple *tuple) {
+  if (!runs_.empty()) {
+    return NextMerged(tuple);
+  }
+  if (pos_ == entries_.size()) {
+    return false;
+  }
+  *tuple = std::move(entries_[pos_++].tuple_);
+  return true;
+}
+
+bool SortExecutor::Next(Tuple *tuple, RID *rid) {
+  if (!NextTuple(tuple)) {
+    return false;
+  }
+  *rid = RID();
+  return true;
+}
+
+bool SortExecutor::NextBatch(VectorBatch *batch) {
+  batch->Reset(plan_->OutputSchema());
+  Tuple tuple;
+  while (!batch->IsFull() && NextTuple(&tuple)) {
+    batch->AppendTuple(tuple, RID(), child_executor_->GetOutputSchema());
+  }
+  return batch->NumSelected() > 0;
+}
+
+}  // namespace bustub
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.cpp
+//
+// Identification: src/execution/sort_key.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/sort_key.h"
+
+#include <cstring>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+void SortKeyUtil::AppendValue(const Value &value, OrderByType order, std::string *key) {
+  size_t begin = key->size();
+  if (value.IsNull()) {
+    key->push_back('\0');
+  } else {
+    key->push_back('\1');
+    switch (value.GetTypeId()) {
+      case TypeId::BOOLEAN:
+        key->push_back(static_cast<char>(value.GetAs<int8_t>()));
+        break;
+      case TypeId::TINYINT:
+        AppendBigEndian(static_cast<uint8_t>(value.GetAs<int8_t>()) ^ 0x80U, sizeof(int8_t), key);
+        break;
+      case TypeId::SMALLINT:
+        AppendBigEndian(static_cast<uint16_t>(value.GetAs<int16_t>()) ^ 0x8000U, sizeof(int16_t), key);
+        break;
+      case TypeId::INTEGER:
+        AppendBigEndian(static_cast<uint32_t>(value.GetAs<int32_t>()) ^ 0x80000000U, sizeof(int32_t), key);
+        break;
+      case TypeId::BIGINT:
+        AppendBigEndian(static_cast<uint64_t>(value.GetAs<int64_t>()) ^ (1ULL << 63), sizeof(int64_t), key);
+        break;
+      case TypeId::DECIMAL: {
+        // Positive doubles order as their bits with the sign bit set, negative ones as their inverted bits.
+        double decimal = value.GetAs<double>();
+        if (decimal == 0) {
+          decimal = 0;  // -0.0 equals 0.0
+        }
+        uint64_t bits;
+        memcpy(&bits, &decimal, sizeof(bits));
+        bits = (bits & (1ULL << 63)) != 0 ? ~bits : bits | (1ULL << 63);
+        AppendBigEndian(bits, sizeof(bits), key);
+        break;
+      }
+      case TypeId::TIMESTAMP:
+        AppendBigEndian(value.GetAs<uint64_t>(), sizeof(uint64_t), key);
+        break;
+      case TypeId::VARCHAR: {
+        const char *data = value.GetData();
+        uint32_t length = value.GetLength() - 1;  // without the terminating zero
+        for (uint32_t i = 0; i < length; i++) {
+          key->push_back(data[i]);
+          if (data[i] == '\0') {
+            key->push_back('\xFF');
+          }
+        }
+        key->push_back('\0');
+        key->push_back('\0');
+        break;
+      }
+      default:
+        throw NotImplementedException("type cannot be sorted");
+    }
+  }
+  if (order == OrderByType::Desc) {
+    for (size_t i = begin; i < key->size(); i++) {
+      (*key)[i] = static_cast<char>(~(*key)[i]);
+    }
+  }
+}
+
+void SortKeyUtil::MakeKey(const Tuple &tuple, const Schema *schema, const std::vector<OrderBy> &order_bys,
+                          std::string *key) {
+  key->clear();
+  for (const auto &[order, expr] : order_bys) {
+    AppendValue(expr->Evaluate(&tuple, schema), order, key);
+  }
+}
+
+void SortKeyUtil::AppendBigEndian(uint64_t bits, size_t num_bytes, std::string *key) {
+  for (size_t i = num_bytes; i > 0; i--) {
+    key->push_back(static_cast<char>(bits >> ((i - 1) * 8)));
+  }
+}
+
+}  // namespace bustub
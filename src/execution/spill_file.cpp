@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_file.cpp
+//
+// Identification: src/execution/spill_file.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/spill_file.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+SpillFile::SpillFile(BufferPoolManager *bpm) : bpm_(bpm), write_page_(std::make_unique<TmpTuplePage>()) {
+  write_page_->Init(INVALID_PAGE_ID, PAGE_SIZE);
+}
+
+SpillFile::~SpillFile() {
+  for (auto page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+void SpillFile::Append(const Tuple &tuple) {
+  TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
+  if (!write_page_->Insert(tuple, &tmp_tuple)) {
+    BUSTUB_ASSERT(!write_page_->IsEmpty(), "tuple too large for a spill page");
+    FlushPage();
+    write_page_->Insert(tuple, &tmp_tuple);
+  }
+  num_tuples_++;
+  size_ += tuple.GetLength();
+}
+
+void SpillFile::FlushPage() {
+  page_id_t page_id;
+  Page *page = bpm_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "no free frame to spill to");
+  }
+  memcpy(page->GetData(), write_page_->GetData(), PAGE_SIZE);
+  static_cast<TmpTuplePage *>(page)->SetTablePageId(page_id);
+  bpm_->UnpinPage(page_id, true);
+  page_ids_.push_back(page_id);
+  write_page_->Init(INVALID_PAGE_ID, PAGE_SIZE);
+}
+
+bool SpillFile::Next(Tuple *tuple) {
+  while (read_pos_ == read_tuples_.size()) {
+    if (read_page_ > page_ids_.size()) {
+      return false;
+    }
+    if (read_page_ == page_ids_.size()) {
+      LoadPage(write_page_.get());
+    } else {
+      page_id_t page_id = page_ids_[read_page_];
+      Page *page = bpm_->FetchPage(page_id);
+      if (page == nullptr) {
+        throw Exception(ExceptionType::OUT_OF_MEMORY, "no free frame to read a spilled page");
+      }
+      LoadPage(static_cast<TmpTuplePage *>(page));
+      bpm_->UnpinPage(page_id, false);
+    }
+    read_page_++;
+  }
+  *tuple = std::move(read_tuples_[read_pos_++]);
+  return true;
+}
+
+void SpillFile::Rewind() {
+  read_page_ = 0;
+  read_tuples_.clear();
+  read_pos_ = 0;
+}
+
+void SpillFile::LoadPage(TmpTuplePage *page) {
+  read_tuples_.clear();
+  read_pos_ = 0;
+  TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
+  for (bool found = page->GetFirstTmpTuple(&tmp_tuple); found; found = page->GetNextTmpTuple(tmp_tuple, &tmp_tuple)) {
+    read_tuples_.emplace_back();
+    page->Get(tmp_tuple, &read_tuples_.back());
+  }
+  // The page is filled from its end, so the tuples written first come last.
+  std::reverse(read_tuples_.begin(), read_tuples_.end());
+}
+
+}  // namespace bustub
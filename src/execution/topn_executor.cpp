@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// topn_executor.cpp
+//
+// Identification: src/execution/topn_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/topn_executor.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "execution/sort_key.h"
+
+namespace bustub {
+
+TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void TopNExecutor::Init() {
+  child_executor_->Init();
+  entries_.clear();
+  pos_ = 0;
+  if (plan_->GetN() == 0) {
+    return;
+  }
+
+  size_t parallelism = exec_ctx_->GetParallelism();
+  std::vector<Heap> heaps(std::max<size_t>(parallelism, 1));
+  bool parallel = parallelism > 1 && child_executor_->ParallelBatches(
+                                         [&](size_t slot, VectorBatch *batch) { OfferBatch(*batch, &heaps[slot]); });
+  if (!parallel) {
+    VectorBatch batch;
+    while (child_executor_->NextBatch(&batch)) {
+      OfferBatch(batch, &heaps[0]);
+    }
+  }
+
+  // Combine the heaps of all threads, and keep the first n of their entries in sort order.
+  entries_ = std::move(heaps[0].entries_);
+  for (size_t slot = 1; slot < heaps.size(); slot++) {
+    std::move(heaps[slot].entries_.begin(), heaps[slot].entries_.end(), std::back_inserter(entries_));
+  }
+  std::sort(entries_.begin(), entries_.end());
+  if (entries_.size() > plan_->GetN()) {
+    entries_.erase(entries_.begin() + plan_->GetN(), entries_.end());
+  }
+}
+
+void TopNExecutor::OfferBatch(const VectorBatch &batch, Heap *heap) {
+  const Schema *child_schema = child_executor_->GetOutputSchema();
+  const auto &order_bys = plan_->GetOrderBys();
+  heap->key_columns_.resize(order_bys.size());
+  for (uint32_t i = 0; i < order_bys.size(); i++) {
+    order_bys[i].second->EvaluateBatch(batch, child_schema, &heap->key_columns_[i]);
+  }
+  auto &entries = heap->entries_;
+  std::string key;
+  for (auto row : batch.GetSelection()) {
+    key.clear();
+    for (uint32_t i = 0; i < order_bys.size(); i++) {
+      SortKeyUtil::AppendValue(heap->key_columns_[i].GetValue(row), order_bys[i].first, &key);
+    }
+    size_t seq = heap->seq_++;
+    if (entries.size() < plan_->GetN()) {
+      entries.emplace_back(Entry{key, seq, batch.GetTuple(row, child_schema)});
+      std::push_heap(entries.begin(), entries.end());
+    } else if (key < entries.front().key_) {
+      // The row sorts before the last of the first n rows, which it replaces. A row with an equal key comes later in
+      // the input, and so sorts after it.
+      std::pop_heap(entries.begin(), entries.end());
+      entries.back() = Entry{key, seq, batch.GetTuple(row, child_schema)};
+      std::push_heap(entries.begin(), entries.end());
+    }
+  }
+}
+
+bool TopNExecutor::Next(Tuple *tuple, RID *rid) {
+  if (pos_ == entries_.size()) {
+    return false;
+  }
+  *tuple = entries_[pos_++].tuple_;
+  *rid = RID();
+  return true;
+}
+
+bool TopNExecutor::NextBatch(VectorBatch *batch) {
+  batch->Reset(plan_->OutputSchema());
+  while (!batch->IsFull() && pos_ < entries_.size()) {
+    batch->AppendTuple(entries_[pos_++].tuple_, RID(), child_executor_->GetOutputSchema());
+  }
+  return batch->NumSelected() > 0;
+}
+
+}  // namespace bustub
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// vector_batch.cpp
+//
+// Identification: src/execution/vector_batch.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/vector_batch.h"
+
+#include "type/limits.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+void ColumnVector::Resize(size_t size) {
+  if (is_integer_) {
+    integers_.resize(size, BUSTUB_INT32_NULL);
+  } else {
+    values_.resize(size, ValueFactory::GetNullValueByType(type_ == TypeId::INVALID ? TypeId::INTEGER : type_));
+  }
+}
+
+void ColumnVector::Append(const Value &value) {
+  if (is_integer_ && value.GetTypeId() != TypeId::INTEGER) {
+    ToValues();
+  }
+  if (is_integer_) {
+    integers_.emplace_back(value.GetAs<int32_t>());
+  } else {
+    values_.emplace_back(value);
+  }
+}
+
+void ColumnVector::Set(size_t row, const Value &value) {
+  if (is_integer_ && value.GetTypeId() != TypeId::INTEGER) {
+    ToValues();
+  }
+  if (is_integer_) {
+    integers_[row] = value.GetAs<int32_t>();
+  } else {
+    values_[row] = value;
+  }
+}
+
+Value ColumnVector::GetValue(size_t row) const {
+  return is_integer_ ? ValueFactory::GetIntegerValue(integers_[row]) : values_[row];
+}
+
+void ColumnVector::ToValues() {
+  values_.reserve(integers_.size());
+  for (auto integer : integers_) {
+    values_.emplace_back(ValueFactory::GetIntegerValue(integer));
+  }
+  integers_.clear();
+  is_integer_ = false;
+}
+
+void VectorBatch::Reset(const Schema *schema) {
+  columns_.resize(schema->GetColumnCount());
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    columns_[i].Reset(schema->GetAccessor(i).type_);
+  }
+  rids_.clear();
+  selection_.clear();
+}
+
+void VectorBatch::AppendTuple(const Tuple &tuple, const RID &rid, const Schema *schema) {
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    if (columns_[i].IsInteger() && schema->GetAccessor(i).type_ == TypeId::INTEGER) {
+      // Copy integers without going through a Value.
+      columns_[i].AppendInteger(tuple.GetAs<int32_t>(schema, i));
+    } else {
+      columns_[i].Append(tuple.GetValue(schema, i));
+    }
+  }
+  selection_.emplace_back(rids_.size());
+  rids_.emplace_back(rid);
+}
+
+void VectorBatch::AppendValues(const std::vector<Value> &values, const RID &rid) {
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    columns_[i].Append(values[i]);
+  }
+  selection_.emplace_back(rids_.size());
+  rids_.emplace_back(rid);
+}
+
+Tuple VectorBatch::GetTuple(size_t row, const Schema *schema) const {
+  std::vector<Value> values;
+  values.reserve(columns_.size());
+  for (const auto &column : columns_) {
+    values.emplace_back(column.GetValue(row));
+  }
+  Tuple tuple(values, schema);
+  tuple.rid_ = rids_[row];
+  return tuple;
+}
+
+}  // namespace bustub
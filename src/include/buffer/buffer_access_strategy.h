@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// buffer_access_strategy.h
+//
+// Identification: src/include/buffer/buffer_access_strategy.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+class BufferPoolManagerInstance;
+
+/**
+ * BufferAccessStrategy lets a large sequential scan recycle a small ring of frames instead of flowing through the whole
+ * buffer pool, like PostgreSQL's BAS_BULKREAD. A page the scan misses on is read into the oldest frame of the ring as
+ * long as nobody has that frame pinned. Ring frames are kept out of the replacer, so the scan neither evicts the
+ * working set of other queries beyond its ring nor makes its own pages look hot. When the strategy is destroyed, its
+ * frames are handed back to the replacer.
+ *
+ * A strategy belongs to a single scan, but the background read-ahead of buffer pool instances may use it while the scan
+ * runs. It must not outlive the buffer pool it is used with.
+ */
+class BufferAccessStrategy {
+  friend class BufferPoolManagerInstance;
+
+ public:
+  /**
+   * Creates a new BufferAccessStrategy.
+   * @param ring_size the number of frames the scan may use in each buffer pool instance; instances further cap it to
+   * an eighth of their pool size
+   */
+  explicit BufferAccessStrategy(size_t ring_size) : ring_size_(ring_size) {}
+
+  /** Hands the frames of every ring back to their buffer pool instance. */
+  ~BufferAccessStrategy();
+
+  DISALLOW_COPY_AND_MOVE(BufferAccessStrategy);
+
+  /** @return the number of frames the scan may use in each buffer pool instance */
+  size_t GetRingSize() const { return ring_size_; }
+
+ private:
+  /** The frames used by the scan in one buffer pool instance. Only accessed under that instance's latch. */
+  struct Ring {
+    BufferPoolManagerInstance *owner_;
+    /** The pages read through the ring and the frames holding them. A recycled slot has INVALID_PAGE_ID. */
+    std::vector<std::pair<page_id_t, frame_id_t>> slots_;
+    /** The slot to recycle next once the ring is full. */
+    size_t next_ = 0;
+  };
+
+  /** @return the ring used in the given buffer pool instance, created on first use */
+  Ring *GetRing(BufferPoolManagerInstance *instance);
+
+  const size_t ring_size_;
+  /** Protects rings_. A list, so that rings stay in place while other instances add theirs. */
+  std::mutex latch_;
+  std::list<Ring> rings_;
+};
+
+}  // namespace bustub
@@ -16,6 +16,7 @@
 #include <mutex>  // NOLINT
 #include <unordered_map>
 
+#include "buffer/buffer_access_strategy.h"
 #include "buffer/lru_replacer.h"
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
@@ -45,6 +46,21 @@ class BufferPoolManager {
     return result;
   }
 
+  /**
+   * Fetch a page on behalf of a scan that recycles its own frames on a miss.
+   * @param page_id id of page to be fetched
+   * @param strategy the access strategy of the scan, nullptr for a regular fetch
+   * @param callback grading callback
+   * @return the requested page
+   */
+  Page *FetchPageWithStrategy(page_id_t page_id, BufferAccessStrategy *strategy,
+                              bufferpool_callback_fn callback = nullptr) {
+    GradingCallback(callback, CallbackType::BEFORE, page_id);
+    auto *result = FetchPgImp(page_id, strategy);
+    GradingCallback(callback, CallbackType::AFTER, page_id);
+    return result;
+  }
+
   /** Grading function. Do not modify! */
   bool UnpinPage(page_id_t page_id, bool is_dirty, bufferpool_callback_fn callback = nullptr) {
     GradingCallback(callback, CallbackType::BEFORE, page_id);
@@ -84,6 +100,31 @@ class BufferPoolManager {
     GradingCallback(callback, CallbackType::AFTER, INVALID_PAGE_ID);
   }
 
+  /**
+   * Ask for a page to be read into the buffer pool in the background, so that a later fetch of it does not wait for
+   * the disk. The page is left unpinned. This is only a hint: nothing is done if the page is already in the buffer pool
+   * or no frame can be spared for it.
+   * @param page_id id of page to be read ahead
+   * @param strategy the access strategy the page will be fetched with, nullptr for a regular fetch
+   */
+  void Prefetch(page_id_t page_id, BufferAccessStrategy *strategy = nullptr) {
+    if (page_id != INVALID_PAGE_ID) {
+      PrefetchPgImp(page_id, strategy);
+    }
+  }
+
+  /**
+   * Ask for consecutive pages to be read into the buffer pool in the background, see Prefetch().
+   * @param first_page_id id of the first page to be read ahead
+   * @param num_pages number of pages to be read ahead
+   * @param strategy the access strategy the pages will be fetched with, nullptr for a regular fetch
+   */
+  void PrefetchRange(page_id_t first_page_id, size_t num_pages, BufferAccessStrategy *strategy = nullptr) {
+    for (size_t i = 0; i < num_pages; i++) {
+      Prefetch(first_page_id + static_cast<page_id_t>(i), strategy);
+    }
+  }
+
   /** @return size of the buffer pool */
   virtual size_t GetPoolSize() = 0;
 
@@ -104,9 +145,24 @@ class BufferPoolManager {
   /**
    * Fetch the requested page from the buffer pool.
    * @param page_id id of page to be fetched
+   * @param strategy the access strategy to read the page with on a miss, nullptr for the regular replacement policy
    * @return the requested page
    */
-  virtual Page *FetchPgImp(page_id_t page_id) = 0;
+  virtual Page *FetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) = 0;
+
+  /**
+   * Fetch the requested page from the buffer pool with the regular replacement policy.
+   * @param page_id id of page to be fetched
+   * @return the requested page
+   */
+  Page *FetchPgImp(page_id_t page_id) { return FetchPgImp(page_id, nullptr); }
+
+  /**
+   * Queue the requested page to be read into the buffer pool in the background.
+   * @param page_id id of page to be read ahead
+   * @param strategy the access strategy to read the page with, nullptr for the regular replacement policy
+   */
+  virtual void PrefetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) = 0;
 
   /**
    * Unpin the target page from the buffer pool.
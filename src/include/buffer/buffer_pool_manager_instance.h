@@ -12,13 +12,24 @@
 
 #pragma once
 
-#include <mutex>  // NOLINT
+#include <algorithm>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <memory>
+#include <mutex>               // NOLINT
+#include <shared_mutex>        // NOLINT
+#include <thread>              // NOLINT
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "buffer/buffer_access_strategy.h"
 #include "buffer/buffer_pool_manager.h"
 #include "buffer/lru_replacer.h"
+#include "buffer/replacer.h"
 #include "recovery/log_manager.h"
+#include "storage/disk/async_disk_io.h"
 #include "storage/disk/disk_manager.h"
 #include "storage/page/page.h"
 
@@ -28,14 +39,18 @@ namespace bustub {
  * BufferPoolManager reads disk pages to and from its internal buffer pool.
  */
 class BufferPoolManagerInstance : public BufferPoolManager {
+  friend class BufferAccessStrategy;
+
  public:
   /**
    * Creates a new BufferPoolManagerInstance.
    * @param pool_size the size of the buffer pool
    * @param disk_manager the disk manager
    * @param log_manager the log manager (for testing only: nullptr = disable logging)
+   * @param replacer the replacement policy for pool_size frames, owned by the BPI (nullptr = LRUReplacer)
    */
-  BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager, LogManager *log_manager = nullptr);
+  BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager, LogManager *log_manager = nullptr,
+                            Replacer *replacer = nullptr);
   /**
    * Creates a new BufferPoolManagerInstance.
    * @param pool_size the size of the buffer pool
@@ -43,9 +58,10 @@ class BufferPoolManagerInstance : public BufferPoolManager {
    * @param instance_index index of this BPI in the parallel BPM
    * @param disk_manager the disk manager
    * @param log_manager the log manager (for testing only: nullptr = disable logging)
+   * @param replacer the replacement policy for pool_size frames, owned by the BPI (nullptr = LRUReplacer)
    */
   BufferPoolManagerInstance(size_t pool_size, uint32_t num_instances, uint32_t instance_index,
-                            DiskManager *disk_manager, LogManager *log_manager = nullptr);
+                            DiskManager *disk_manager, LogManager *log_manager = nullptr, Replacer *replacer = nullptr);
 
   /**
    * Destroys an existing BufferPoolManagerInstance.
@@ -58,13 +74,42 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   /** @return pointer to all the pages in the buffer pool */
   Page *GetPages() { return pages_; }
 
+  /**
+   * Start the background page cleaner. Every page_cleaner_interval, or whenever an eviction had to write a dirty page
+   * itself, the cleaner writes back the dirty unpinned pages among the clean_target coldest frames of the replacer,
+   * so that evictions find clean victims.
+   * @param clean_target number of frames at the cold end of the replacer the cleaner tries to keep clean
+   */
+  void RunPageCleaner(size_t clean_target);
+
+  /** Stop and join the background page cleaner, if it is running. */
+  void StopPageCleaner();
+
+  /** @return the number of pages written back by the page cleaner */
+  size_t GetNumPagesCleaned() const { return num_pages_cleaned_; }
+
+  /** @return the number of dirty victims that had to be written back by the thread evicting them */
+  size_t GetNumForegroundWriteBacks() const { return num_foreground_writebacks_; }
+
+  /** @return the number of pages read into the buffer pool by the background read-ahead */
+  size_t GetNumPagesPrefetched() const { return num_pages_prefetched_; }
+
  protected:
   /**
    * Fetch the requested page from the buffer pool.
    * @param page_id id of page to be fetched
+   * @param strategy the access strategy to read the page with on a miss, nullptr for the regular replacement policy
    * @return the requested page
    */
-  Page *FetchPgImp(page_id_t page_id) override;
+  Page *FetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) override;
+
+  /**
+   * Queue the requested page to be read into the buffer pool by the background read-ahead thread, which is started on
+   * first use. The request is dropped if the page is already cached, has not been allocated or the queue is full.
+   * @param page_id id of page to be read ahead
+   * @param strategy the access strategy to read the page with, nullptr for the regular replacement policy
+   */
+  void PrefetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) override;
 
   /**
    * Unpin the target page from the buffer pool.
@@ -121,6 +166,151 @@ class BufferPoolManagerInstance : public BufferPoolManager {
    */
   void ValidatePageId(page_id_t page_id) const;
 
+  /** Number of independently latched slices the page table is split into. */
+  static constexpr size_t PAGE_TABLE_SHARDS = 16;
+
+  /**
+   * A slice of the page table with its own latch. Lookups hold the latch shared while they pin the frame, and a frame
+   * is only unmapped under the exclusive latch once its pin count is zero, so a buffer hit never needs latch_.
+   */
+  struct PageTableShard {
+    std::shared_mutex latch_;
+    std::unordered_map<page_id_t, frame_id_t> table_;
+  };
+
+  /** @return the page table shard responsible for page_id */
+  PageTableShard &GetShard(page_id_t page_id) {
+    return page_table_[(static_cast<uint32_t>(page_id) / num_instances_) % PAGE_TABLE_SHARDS];
+  }
+
+  /** I/O state of a frame. A frame is LOADING from the moment it is assigned a page until its content is in memory. */
+  enum class FrameState : uint8_t { READY, LOADING };
+
+  /**
+   * Pin a frame that was found in the page table. The caller must hold the shard latch of the page in the frame.
+   * @param frame_id the frame to pin
+   */
+  void PinFrame(frame_id_t frame_id);
+
+  /**
+   * Look up a page in the page table and pin its frame if it is there. The frame may still be loading.
+   * @param page_id id of the page to look up
+   * @param[out] frame_id the frame holding the page
+   * @param record_access false to pin the frame without it counting as a use of the page by the replacer
+   * @return true if the page is in the buffer pool, false otherwise
+   */
+  bool PinCachedFrame(page_id_t page_id, frame_id_t *frame_id, bool record_access = true);
+
+  /**
+   * Find a frame to hold a new page, taking it from the free list first and the replacer otherwise. A frame from the
+   * replacer is removed from the page table. If its page is dirty, the page is registered as being written back and
+   * the caller must write it out with FinishWriteBack() after releasing latch_. The caller must hold latch_.
+   * @param[out] frame_id the frame that may be reused
+   * @param[out] writeback_page_id the page that must be written back, INVALID_PAGE_ID if there is none
+   * @return false if every frame is pinned, true otherwise
+   */
+  bool GetVictimFrame(frame_id_t *frame_id, page_id_t *writeback_page_id);
+
+  /**
+   * Unmap a page from its frame so the frame can be reused. If the page is dirty, it is registered as being written
+   * back. The caller must hold latch_ and the exclusive shard latch of the page, and must have checked it is unpinned.
+   */
+  void EvictPage(Page *page, page_id_t *writeback_page_id);
+
+  /** @return the number of frames a ring of the given strategy may use in this instance */
+  size_t GetRingCapacity(const BufferAccessStrategy *strategy) const {
+    return std::min(strategy->GetRingSize(), pool_size_ / 8);
+  }
+
+  /**
+   * Take the frame for a page read through an access strategy, recycling the oldest frame of the ring if it is full
+   * and that frame is unpinned. The caller must hold latch_.
+   * @param ring the ring of the strategy in this instance
+   * @param capacity the number of frames the ring may use
+   * @param[out] frame_id the frame that may be reused
+   * @param[out] writeback_page_id the page that must be written back, INVALID_PAGE_ID if there is none
+   * @return false if every frame is pinned, true otherwise
+   */
+  bool GetRingFrame(BufferAccessStrategy::Ring *ring, size_t capacity, frame_id_t *frame_id,
+                    page_id_t *writeback_page_id);
+
+  /**
+   * Record a frame that was just assigned to a page read through an access strategy in the strategy's ring, taking it
+   * out of the replacer's reach. The frame in the ring slot being replaced is handed back. The caller must hold latch_.
+   */
+  void AddToRing(BufferAccessStrategy::Ring *ring, size_t capacity, page_id_t page_id, frame_id_t frame_id);
+
+  /** Hand the frame of a ring slot back to the replacer. The caller must hold latch_. */
+  void ReleaseRingSlot(std::pair<page_id_t, frame_id_t> *slot);
+
+  /** Hand every frame of a ring back to the replacer. Called when its strategy is destroyed. */
+  void ReleaseRing(BufferAccessStrategy::Ring *ring);
+
+  /**
+   * Assign a victim frame to a page: pin it, mark it LOADING and publish it in the page table. The caller must hold
+   * latch_, and must call MarkFrameReady() once the page content is in place.
+   * @param frame_id the frame to assign
+   * @param page_id the page the frame now holds
+   */
+  void InstallPage(frame_id_t frame_id, page_id_t page_id);
+
+  /**
+   * Write the previous content of a frame back to disk and wake up threads waiting to read that page again. Must be
+   * called without holding latch_.
+   * @param frame_id the frame whose content is written
+   * @param page_id the page returned by GetVictimFrame(), nothing is done if it is INVALID_PAGE_ID
+   */
+  void FinishWriteBack(frame_id_t frame_id, page_id_t page_id);
+
+  /** Mark a LOADING frame as READY and wake up the threads waiting for it. */
+  void MarkFrameReady(frame_id_t frame_id);
+
+  /** Block until a pinned frame has finished loading. */
+  void WaitForFrame(frame_id_t frame_id);
+
+  /** Write back the dirty, unpinned pages among the coldest clean_target_ frames of the replacer. */
+  void CleanColdPages();
+
+  /** @return the asynchronous I/O backend of the instance, created on first use */
+  AsyncDiskIO *GetAsyncIO() {
+    std::call_once(async_io_once_, [this] { async_io_ = AsyncDiskIO::Create(disk_manager_); });
+    return async_io_.get();
+  }
+
+  /**
+   * @return how many frames a background batch of I/Os may pin at once: as many as the I/O queue depth, but no more
+   * than a quarter of the pool so that foreground fetches still find victims
+   */
+  size_t GetIOBatchSize() const {
+    return std::max<size_t>(1, std::min<size_t>(ASYNC_IO_QUEUE_DEPTH, pool_size_ / 4));
+  }
+
+  /**
+   * Write out pinned pages with their writes in flight together, then unpin them.
+   * @param pages the pages to write and the frames holding them, each pinned once by the caller and READY
+   */
+  void WritePinnedPages(const std::vector<std::pair<page_id_t, frame_id_t>> &pages);
+
+  /** @return true if the page is in the page table, whether or not it has finished loading */
+  bool IsCached(page_id_t page_id) {
+    auto &shard = GetShard(page_id);
+    std::shared_lock shard_lock(shard.latch_);
+    return shard.table_.count(page_id) != 0;
+  }
+
+  /** A page queued for read-ahead, with the ring of the strategy it is read through (nullptr if there is none). */
+  struct PrefetchRequest {
+    page_id_t page_id_;
+    BufferAccessStrategy::Ring *ring_;
+    size_t ring_capacity_;
+  };
+
+  /** Body of the read-ahead thread: read the queued pages into unpinned frames until StopPrefetcher() is called. */
+  void RunPrefetcher();
+
+  /** Stop and join the read-ahead thread, if it was started. Pending requests are dropped. */
+  void StopPrefetcher();
+
   /** Number of pages in the buffer pool. */
   const size_t pool_size_;
   /** How many instances are in the parallel BPM (if present, otherwise just 1 BPI) */
@@ -134,15 +324,58 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   Page *pages_;
   /** Pointer to the disk manager. */
   DiskManager *disk_manager_ __attribute__((__unused__));
+  /** Asynchronous I/O on the disk manager's file, nullptr until first used. */
+  std::unique_ptr<AsyncDiskIO> async_io_;
+  std::once_flag async_io_once_;
   /** Pointer to the log manager. */
   LogManager *log_manager_ __attribute__((__unused__));
   /** Page table for keeping track of buffer pool pages. */
-  std::unordered_map<page_id_t, frame_id_t> page_table_;
+  PageTableShard page_table_[PAGE_TABLE_SHARDS];
   /** Replacer to find unpinned pages for replacement. */
   Replacer *replacer_;
   /** List of free pages. */
   std::vector<frame_id_t> free_list_;
-  /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
+  /** Per-frame latches that order the replacer updates of concurrent pins and unpins crossing a zero pin count, and
+   * guard the frame state transitions. */
+  std::vector<std::mutex> frame_latches_;
+  /** Per-frame condition variables signalled when a frame becomes READY. */
+  std::vector<std::condition_variable> frame_cvs_;
+  /** Per-frame I/O states. */
+  std::vector<std::atomic<FrameState>> frame_states_;
+  /** Whether each frame belongs to the ring of an access strategy, in which case an unpin does not hand it to the
+   * replacer. Changed under the frame latch. */
+  std::vector<std::atomic<bool>> frame_in_ring_;
+  /** Evicted pages whose write back is still in flight. Fetching one of them must wait until it is on disk. */
+  std::unordered_set<page_id_t> writing_back_;
+  /** Signalled (with latch_) whenever a page leaves writing_back_. */
+  std::condition_variable writeback_cv_;
+  /** This latch protects the free list and writing_back_, and serializes assigning frames to pages (victim selection,
+   * new and deleted pages). Disk I/O is never done while holding it; buffer hits and unpins do not take it at all. */
   std::mutex latch_;
+
+  /** Background page cleaner, nullptr if it is not running. */
+  std::thread *cleaner_thread_ = nullptr;
+  /** Number of cold frames the page cleaner tries to keep clean. */
+  size_t clean_target_ = 0;
+  /** Protects cleaner_running_ and cleaner_pending_. */
+  std::mutex cleaner_latch_;
+  /** Signalled to stop the page cleaner or to wake it up early. */
+  std::condition_variable cleaner_cv_;
+  bool cleaner_running_ = false;
+  bool cleaner_pending_ = false;
+  /** Pages written back by the page cleaner. */
+  std::atomic<size_t> num_pages_cleaned_ = 0;
+  /** Dirty victims written back in the foreground. */
+  std::atomic<size_t> num_foreground_writebacks_ = 0;
+
+  /** Background read-ahead thread, nullptr until the first prefetch. */
+  std::thread *prefetch_thread_ = nullptr;
+  /** Pages waiting to be read ahead, oldest first. Protected by latch_, as are the two members below. */
+  std::deque<PrefetchRequest> prefetch_queue_;
+  /** Signalled (with latch_) when a request is queued or the read-ahead thread must stop. */
+  std::condition_variable prefetch_cv_;
+  bool prefetch_running_ = false;
+  /** Pages read by the read-ahead thread. */
+  std::atomic<size_t> num_pages_prefetched_ = 0;
 };
 }  // namespace bustub
@@ -45,8 +45,18 @@ class ClockReplacer : public Replacer {
 
   size_t Size() override;
 
+  std::vector<frame_id_t> PeekVictims(size_t max_frames) override;
+
  private:
-  // TODO(student): implement me!
+  std::mutex latch_;
+  /** Whether each frame is in the replacer. */
+  std::vector<bool> in_replacer_;
+  /** Reference bit of each frame, set when the frame is unpinned and cleared when the clock hand passes it. */
+  std::vector<bool> ref_;
+  /** The frame the clock hand points to. */
+  size_t hand_ = 0;
+  /** Number of frames in the replacer. */
+  size_t size_ = 0;
 };
 
 }  // namespace bustub
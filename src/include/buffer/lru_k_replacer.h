@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// lru_k_replacer.h
+//
+// Identification: src/include/buffer/lru_k_replacer.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <mutex>  // NOLINT
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * LRUKReplacer implements the LRU-K replacement policy (O'Neil et al., SIGMOD '93).
+ *
+ * The victim is the evictable frame whose K-th most recent reference is the oldest. Frames with fewer than K
+ * references have an infinite backward K-distance and are evicted first, least recently used first. A page touched
+ * once by a sequential scan therefore never pushes out pages that are referenced repeatedly.
+ *
+ * Every Pin is a reference. References that come within the correlated reference period of the previous one (counted
+ * in references to the replacer) are treated as one, so a burst of accesses does not make a page look hot. Frames
+ * still inside their correlated reference period are only evicted if there is no other choice.
+ *
+ * History is tracked per frame and dropped when the frame is victimized or removed.
+ */
+class LRUKReplacer : public Replacer {
+ public:
+  /**
+   * Create a new LRUKReplacer.
+   * @param num_pages the maximum number of pages the LRUKReplacer will be required to store
+   * @param k the number of references remembered per frame
+   * @param correlated_reference_period references closer than this to the previous reference are correlated
+   */
+  LRUKReplacer(size_t num_pages, size_t k, size_t correlated_reference_period = 0);
+
+  /**
+   * Destroys the LRUKReplacer.
+   */
+  ~LRUKReplacer() override;
+
+  bool Victim(frame_id_t *frame_id) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  size_t Size() override;
+
+  std::vector<frame_id_t> PeekVictims(size_t max_frames) override;
+
+ private:
+  /** Eviction order: frames with fewer than K references first, then by the time of the K-th most recent one. */
+  using EvictionKey = std::tuple<bool, uint64_t, frame_id_t>;
+
+  struct FrameHistory {
+    /** Times of the last (up to) K uncorrelated references, most recent first. */
+    std::deque<uint64_t> history_;
+    /** Time of the last reference, correlated or not. */
+    uint64_t last_ = 0;
+    /** Whether the frame is in the replacer. */
+    bool evictable_ = false;
+  };
+
+  EvictionKey KeyOf(frame_id_t frame_id) const;
+
+  /** @return true if the frame was referenced within the correlated reference period */
+  bool InCorrelatedPeriod(frame_id_t frame_id) const;
+
+  /** Victims in eviction order: frames outside their correlated reference period first. Requires latch_. */
+  std::vector<frame_id_t> VictimOrder(size_t max_frames) const;
+
+  std::mutex latch_;
+  const size_t k_;
+  const size_t correlated_reference_period_;
+  /** Logical clock, advanced on every reference. */
+  uint64_t current_time_ = 0;
+  std::vector<FrameHistory> frames_;
+  std::set<EvictionKey> evictable_;
+};
+
+}  // namespace bustub
@@ -47,6 +47,8 @@ class LRUReplacer : public Replacer {
 
   size_t Size() override;
 
+  std::vector<frame_id_t> PeekVictims(size_t max_frames) override;
+
  private:
   // TODO(student): implement me!
   std::shared_mutex r_mu_;
@@ -42,6 +42,15 @@ class ParallelBufferPoolManager : public BufferPoolManager {
   /** @return size of the buffer pool */
   size_t GetPoolSize() override;
 
+  /**
+   * Start the background page cleaner of every BufferPoolManagerInstance.
+   * @param clean_target number of cold frames each instance tries to keep clean
+   */
+  void RunPageCleaner(size_t clean_target);
+
+  /** Stop the background page cleaner of every BufferPoolManagerInstance. */
+  void StopPageCleaner();
+
  protected:
   /**
    * @param page_id id of page
@@ -52,9 +61,17 @@ class ParallelBufferPoolManager : public BufferPoolManager {
   /**
    * Fetch the requested page from the buffer pool.
    * @param page_id id of page to be fetched
+   * @param strategy the access strategy to read the page with on a miss, nullptr for the regular replacement policy
    * @return the requested page
    */
-  Page *FetchPgImp(page_id_t page_id) override;
+  Page *FetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) override;
+
+  /**
+   * Queue the requested page to be read into the buffer pool in the background.
+   * @param page_id id of page to be read ahead
+   * @param strategy the access strategy to read the page with, nullptr for the regular replacement policy
+   */
+  void PrefetchPgImp(page_id_t page_id, BufferAccessStrategy *strategy) override;
 
   /**
    * Unpin the target page from the buffer pool.
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/config.h"
 
 namespace bustub {
@@ -43,8 +45,22 @@ class Replacer {
    */
   virtual void Unpin(frame_id_t frame_id) = 0;
 
+  /**
+   * Removes a frame whose page was deleted. Unlike Pin, this is not a use of the frame: a replacer that keeps access
+   * history should forget the frame's history.
+   * @param frame_id the id of the frame to remove
+   */
+  virtual void Remove(frame_id_t frame_id) { Pin(frame_id); }
+
   /** @return the number of elements in the replacer that can be victimized */
   virtual size_t Size() = 0;
+
+  /**
+   * Look at the frames that would be victimized next, without removing them from the replacer.
+   * @param max_frames the maximum number of frames to return
+   * @return up to max_frames frames in the order they would be victimized
+   */
+  virtual std::vector<frame_id_t> PeekVictims(size_t max_frames) { return {}; }
 };
 
 }  // namespace bustub
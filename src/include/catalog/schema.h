@@ -23,6 +23,21 @@ namespace bustub {
 
 class Schema {
  public:
+  /**
+   * How to find a column in the bytes of a tuple. The accessors of a schema are compiled once when it is built, so that
+   * reading a column does not go through the Column object.
+   */
+  struct ColumnAccessor {
+    /** The offset of the column in the tuple, or of the slot holding the offset of its data if it is not inlined. */
+    uint32_t offset_;
+    /** The number of bytes the column takes in the fixed-length part of the tuple. */
+    uint32_t size_;
+    /** The type of the column. */
+    TypeId type_;
+    /** True if the column is stored in place, false if it is a varchar stored after the fixed-length part. */
+    bool is_inlined_;
+  };
+
   /**
    * Constructs the schema corresponding to the vector of columns, read left-to-right.
    * @param columns columns that describe the schema's individual columns
@@ -63,6 +78,12 @@ class Schema {
     UNREACHABLE("Column does not exist");
   }
 
+  /**
+   * @param col_idx index of a column
+   * @return how to read the column from the bytes of a tuple
+   */
+  const ColumnAccessor &GetAccessor(const uint32_t col_idx) const { return accessors_[col_idx]; }
+
   /** @return the indices of non-inlined columns */
   const std::vector<uint32_t> &GetUnlinedColumns() const { return uninlined_columns_; }
 
@@ -88,6 +109,9 @@ class Schema {
   /** All the columns in the schema, inlined and uninlined. */
   std::vector<Column> columns_;
 
+  /** The accessor of each column. */
+  std::vector<ColumnAccessor> accessors_;
+
   /** True if all the columns are inlined, false otherwise. */
   bool tuple_is_inlined_;
 
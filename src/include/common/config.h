@@ -27,6 +27,9 @@ extern std::atomic<bool> enable_logging;
 /** If ENABLE_LOGGING is true, the log should be flushed to disk every LOG_TIMEOUT. */
 extern std::chrono::duration<int64_t> log_timeout;
 
+/** A running buffer pool page cleaner looks for dirty cold pages every page_cleaner_interval. */
+extern std::chrono::milliseconds page_cleaner_interval;
+
 static constexpr int INVALID_PAGE_ID = -1;                                    // invalid page id
 static constexpr int INVALID_TXN_ID = -1;                                     // invalid transaction id
 static constexpr int INVALID_LSN = -1;                                        // invalid log sequence number
@@ -35,6 +38,12 @@ static constexpr int PAGE_SIZE = 4096;                                        //
 static constexpr int BUFFER_POOL_SIZE = 10;                                   // size of buffer pool
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
+static constexpr int SCAN_RING_SIZE = 16;                                     // frames in a sequential scan ring
+static constexpr int PREFETCH_QUEUE_SIZE = 64;                                // read-ahead requests per pool instance
+static constexpr int ASYNC_IO_QUEUE_DEPTH = 32;                               // page I/Os in flight per pool instance
+static constexpr size_t VECTOR_BATCH_SIZE = 1024;                             // rows in a vectorized batch
+static constexpr size_t MORSEL_SIZE = 16;                                     // pages in a parallel scan morsel
+static constexpr size_t OPERATOR_MEMORY_BUDGET = 64 << 20;                    // tuple bytes held before spilling
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
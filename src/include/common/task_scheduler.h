@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// task_scheduler.h
+//
+// Identification: src/include/common/task_scheduler.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * TaskScheduler runs data-parallel jobs on a fixed pool of worker threads.
+ *
+ * A job is a number of independent tasks, e.g. one per morsel of a table, run by a number of slots. Each slot is a
+ * thread taking part in the job: slot 0 is the calling thread, and the other slots are picked up by idle workers. Tasks
+ * are handed out to the slots in contiguous ranges up front; a slot works through its own range from the front, and
+ * once it runs dry steals tasks from the back of the ranges of the other slots. Each task learns the slot it runs in,
+ * so that it can use state private to that slot without synchronization.
+ *
+ * Slots that no worker has picked up by the time the calling thread runs out of tasks are dropped, so that a job
+ * finishes even if all workers are busy, and jobs may be started from within tasks.
+ */
+class TaskScheduler {
+ public:
+  /**
+   * Start a scheduler.
+   * @param num_workers the number of worker threads
+   */
+  explicit TaskScheduler(size_t num_workers);
+
+  /** Stop the workers; there must be no job running. */
+  ~TaskScheduler();
+
+  DISALLOW_COPY_AND_MOVE(TaskScheduler);
+
+  /** @return the scheduler shared by all queries, with a worker for every hardware thread besides the calling one */
+  static TaskScheduler *GetDefault();
+
+  /** @return the number of worker threads */
+  size_t GetNumWorkers() const { return workers_.size(); }
+
+  /**
+   * Run a job and wait for it to finish. If a task throws, the remaining tasks are skipped and the exception is
+   * rethrown here.
+   * @param num_tasks the number of tasks
+   * @param num_slots the number of threads to run the tasks on, including the calling thread
+   * @param task the task function, called with the index of a task and the slot, in [0, num_slots), it runs in
+   */
+  void Run(size_t num_tasks, size_t num_slots, const std::function<void(size_t task, size_t slot)> &task);
+
+ private:
+  struct Job;
+
+  /** Run tasks in a slot of a job until there are none left. */
+  static void RunSlot(Job *job, size_t slot);
+
+  /** The main loop of a worker thread. */
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  /** Protects the members below. */
+  std::mutex latch_;
+  std::condition_variable cv_;
+  /** Slots of jobs waiting for a worker. */
+  std::deque<std::function<void()>> queue_;
+  bool shutdown_{false};
+};
+
+}  // namespace bustub
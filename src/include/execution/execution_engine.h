@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
@@ -52,18 +53,44 @@ class ExecutionEngine {
     // Construct and executor for the plan
     auto executor = ExecutorFactory::CreateExecutor(exec_ctx, plan);
 
-    // Prepare the root executor
-    executor->Init();
-
     PlanType plan_type = plan->GetType();
     // Execute the query plan
     try {
-      Tuple tuple;
-      RID rid;
-      while (executor->Next(&tuple, &rid)) {
-        if (result_set != nullptr && plan_type != PlanType::Update && plan_type != PlanType::Insert &&
-            plan_type != PlanType::Delete) {
-          result_set->emplace_back(tuple);
+      // Prepare the root executor; blocking executors read their inputs here, and may fail to spill them.
+      executor->Init();
+
+      if (plan_type == PlanType::Update || plan_type == PlanType::Insert || plan_type == PlanType::Delete) {
+        // Modifications produce no tuples; they do their work one tuple per call.
+        Tuple tuple;
+        RID rid;
+        while (executor->Next(&tuple, &rid)) {
+        }
+      } else {
+        // Queries run in parallel if they may and the root executor supports it, and are otherwise pulled a batch at a
+        // time. Parallel results are collected per thread and concatenated.
+        std::vector<std::vector<Tuple>> slot_results(exec_ctx->GetParallelism());
+        bool parallel = executor->ParallelBatches([&](size_t slot, VectorBatch *batch) {
+          if (result_set != nullptr) {
+            for (auto row : batch->GetSelection()) {
+              slot_results[slot].emplace_back(batch->GetTuple(row, executor->GetOutputSchema()));
+            }
+          }
+        });
+        if (parallel && result_set != nullptr) {
+          for (auto &tuples : slot_results) {
+            result_set->insert(result_set->end(), std::make_move_iterator(tuples.begin()),
+                               std::make_move_iterator(tuples.end()));
+          }
+        }
+        if (!parallel) {
+          VectorBatch batch;
+          while (executor->NextBatch(&batch)) {
+            if (result_set != nullptr) {
+              for (auto row : batch.GetSelection()) {
+                result_set->emplace_back(batch.GetTuple(row, executor->GetOutputSchema()));
+              }
+            }
+          }
         }
       }
     } catch (TransactionAbortException &e) {
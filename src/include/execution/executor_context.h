@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "common/task_scheduler.h"
 #include "concurrency/transaction.h"
 #include "storage/page/tmp_tuple_page.h"
 
@@ -60,6 +61,27 @@ class ExecutorContext {
   /** @return the transaction manager */
   TransactionManager *GetTransactionManager() { return txn_mgr_; }
 
+  /** @return the number of threads the query may run on */
+  size_t GetParallelism() const { return parallelism_; }
+
+  /**
+   * Set the number of threads the query may run on. With 1, the default, it runs on the calling thread only; with more,
+   * the executors that support it split their input into morsels and process them on the task scheduler.
+   */
+  void SetParallelism(size_t parallelism) { parallelism_ = parallelism; }
+
+  /** @return the scheduler the parallel parts of the query run on */
+  TaskScheduler *GetTaskScheduler() { return TaskScheduler::GetDefault(); }
+
+  /** @return the number of bytes of tuples each executor of the query may hold in memory */
+  size_t GetMemoryBudget() const { return memory_budget_; }
+
+  /**
+   * Set the number of bytes of tuples each executor of the query may hold in memory. Executors that collect their
+   * input, like hash joins, spill it to temporary pages beyond this budget.
+   */
+  void SetMemoryBudget(size_t memory_budget) { memory_budget_ = memory_budget; }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -71,6 +93,10 @@ class ExecutorContext {
   TransactionManager *txn_mgr_;
   /** The lock manager associated with this executor context */
   LockManager *lock_mgr_;
+  /** The number of threads the query may run on */
+  size_t parallelism_{1};
+  /** The number of bytes of tuples each executor may hold in memory */
+  size_t memory_budget_{OPERATOR_MEMORY_BUDGET};
 };
 
 }  // namespace bustub
@@ -12,12 +12,16 @@
 
 #pragma once
 
+#include <functional>
+
 #include "execution/executor_context.h"
+#include "execution/vector_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 /**
- * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
+ * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model, and its vectorized batch-at-a-time
+ * variant.
  * This is the base class from which all executors in the BustTub execution
  * engine inherit, and defines the minimal interface that all executors support.
  */
@@ -46,6 +50,35 @@ class AbstractExecutor {
    */
   virtual bool Next(Tuple *tuple, RID *rid) = 0;
 
+  /**
+   * Yield the next batch of tuples from this executor, as column vectors of up to VECTOR_BATCH_SIZE rows. A consumer
+   * pulls either tuples with Next() or batches with NextBatch() from an executor, never both. The default
+   * implementation gathers the tuples of Next(); vectorized executors override it.
+   * @param[out] batch The next batch produced by this executor, with the columns of GetOutputSchema()
+   * @return `true` if a batch with at least one selected row was produced, `false` if there are no more tuples
+   */
+  virtual bool NextBatch(VectorBatch *batch) {
+    batch->Reset(GetOutputSchema());
+    Tuple tuple;
+    RID rid;
+    while (!batch->IsFull() && Next(&tuple, &rid)) {
+      batch->AppendTuple(tuple, rid, GetOutputSchema());
+    }
+    return batch->NumSelected() > 0;
+  }
+
+  /**
+   * Run the executor on the task scheduler of the executor context, with up to GetParallelism() threads, and hand
+   * every batch it produces to a consumer. This is called after Init() in place of Next() and NextBatch(), and the
+   * batches come in no particular order. The default implementation does not run in parallel; executors that can
+   * split their input into morsels override it.
+   * @param consume the consumer, called concurrently from several threads with the slot of the calling thread, in
+   * [0, GetParallelism()), and a batch that is only valid for the duration of the call
+   * @return `false` if the executor did not run, because parallelism is 1 or not supported by the executor; nothing
+   * has been consumed then
+   */
+  virtual bool ParallelBatches(const std::function<void(size_t slot, VectorBatch *batch)> &consume) { return false; }
+
   /** @return The schema of the tuples that this executor produces */
   virtual const Schema *GetOutputSchema() = 0;
 
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/aggregation_plan.h"
+#include "execution/spill_file.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
 
@@ -103,11 +105,62 @@ class SimpleAggregationHashTable {
    */
   void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
     if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
+      auto initial = GenerateInitialAggregateValue();
+      size_ += GroupSize(agg_key, initial);
+      ht_.insert({agg_key, std::move(initial)});
     }
     CombineAggregateValues(&ht_[agg_key], agg_val);
   }
 
+  /**
+   * Merges a partial group, aggregated over other input of the same aggregation, into this hash table.
+   * @param agg_key the key of the group
+   * @param agg_val the partial aggregates of the group
+   */
+  void MergeGroup(const AggregateKey &agg_key, const AggregateValue &agg_val) {
+    auto iter = ht_.find(agg_key);
+    if (iter == ht_.end()) {
+      size_ += GroupSize(agg_key, agg_val);
+      ht_.emplace(agg_key, agg_val);
+      return;
+    }
+    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+      Value &result = iter->second.aggregates_[i];
+      switch (agg_types_[i]) {
+        case AggregationType::CountAggregate:
+        case AggregationType::SumAggregate:
+          // Partial counts and sums add up.
+          result = result.Add(agg_val.aggregates_[i]);
+          break;
+        case AggregationType::MinAggregate:
+          result = result.Min(agg_val.aggregates_[i]);
+          break;
+        case AggregationType::MaxAggregate:
+          result = result.Max(agg_val.aggregates_[i]);
+          break;
+      }
+    }
+  }
+
+  /**
+   * Merges the groups of another hash table, built over other input of the same aggregation, into this one.
+   * @param other the hash table to merge
+   */
+  void Merge(const SimpleAggregationHashTable &other) {
+    for (const auto &[agg_key, agg_val] : other.ht_) {
+      MergeGroup(agg_key, agg_val);
+    }
+  }
+
+  /** @return the estimated number of bytes the groups of the hash table take up */
+  size_t GetSize() const { return size_; }
+
+  /** Remove all groups. */
+  void Clear() {
+    ht_.clear();
+    size_ = 0;
+  }
+
   /** An iterator over the aggregation hash table */
   class Iterator {
    public:
@@ -144,8 +197,22 @@ class SimpleAggregationHashTable {
   Iterator End() { return Iterator{ht_.cend()}; }
 
  private:
+  /** @return the estimated number of bytes a group takes up in the hash table */
+  static size_t GroupSize(const AggregateKey &agg_key, const AggregateValue &agg_val) {
+    size_t size = sizeof(AggregateKey) + sizeof(AggregateValue) + 2 * sizeof(void *);
+    for (const auto &value : agg_key.group_bys_) {
+      size += sizeof(Value);
+      if (value.GetTypeId() == TypeId::VARCHAR && !value.IsNull()) {
+        size += value.GetLength();
+      }
+    }
+    return size + agg_val.aggregates_.size() * sizeof(Value);
+  }
+
   /** The hash table is just a map from aggregate keys to aggregate values */
   std::unordered_map<AggregateKey, AggregateValue> ht_{};
+  /** The estimated number of bytes the groups take up */
+  size_t size_{0};
   /** The aggregate expressions that we have */
   const std::vector<const AbstractExpression *> &agg_exprs_;
   /** The types of aggregations that we have */
@@ -155,6 +222,16 @@ class SimpleAggregationHashTable {
 /**
  * AggregationExecutor executes an aggregation operation (e.g. COUNT, SUM, MIN, MAX)
  * over the tuples produced by a child executor.
+ *
+ * Once the groups outgrow the memory budget of the executor context, the partial aggregates of the hash table are
+ * spilled to NUM_PARTITIONS spill files by the hash of their group-bys, and the hash table starts over. At the end of
+ * the input, the partitions are merged one at a time: every group lives in a single partition, so the groups of a
+ * merged partition are final, and the having clause applies to them as usual. A partition that is still too large is
+ * partitioned again on other bits of the hash, up to MAX_LEVELS deep.
+ *
+ * When the child runs in parallel, each thread pre-aggregates the rows it produces into hash tables of its own, one
+ * per hash range of the groups. The ranges are then merged in parallel, each by a single thread, so that the merge
+ * shares no state either, and the merged ranges are output one after the other.
  */
 class AggregationExecutor : public AbstractExecutor {
  public:
@@ -167,7 +244,7 @@ class AggregationExecutor : public AbstractExecutor {
   AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
                       std::unique_ptr<AbstractExecutor> &&child);
 
-  /** Initialize the aggregation */
+  /** Initialize the aggregation, aggregating the input in parallel if the child supports it */
   void Init() override;
 
   /**
@@ -178,6 +255,13 @@ class AggregationExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of groups from the aggregation.
+   * @param[out] batch The next batch produced by the aggregation
+   * @return `true` if a batch was produced, `false` if there are no more groups
+   */
+  bool NextBatch(VectorBatch *batch) override;
+
   /** @return The output schema for the aggregation */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
@@ -185,24 +269,87 @@ class AggregationExecutor : public AbstractExecutor {
   const AbstractExecutor *GetChildExecutor() const;
 
  private:
-  /** @return The tuple as an AggregateKey */
-  AggregateKey MakeAggregateKey(const Tuple *tuple) {
-    std::vector<Value> keys;
-    for (const auto &expr : plan_->GetGroupBys()) {
-      keys.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
-    }
-    return {keys};
+  /**
+   * Produce the output values of the next group that satisfies the having clause.
+   * @param[out] values The output values of the group
+   * @return `true` if there was such a group, `false` if there are no more groups
+   */
+  bool NextGroup(std::vector<Value> *values);
+
+  /**
+   * Move on to the next hash table to output: the next merged range, or the next spilled partition.
+   * @return `false` if there are no more hash tables
+   */
+  bool NextTable();
+
+  /** @return the hash table being output */
+  SimpleAggregationHashTable *OutputTable() { return ranges_.empty() ? &aht_ : &ranges_[range_]; }
+
+  /**
+   * Evaluate the group-bys and aggregates over a batch of the input and combine its rows into hash tables, by the
+   * hash range of their group-bys.
+   * @param batch the batch
+   * @param[out] ahts the hash tables, one for each of the 2^range_bits hash ranges
+   * @param range_bits the number of bits of the hash that select a range
+   * @param group_by_columns scratch space for the group-bys
+   * @param aggregate_columns scratch space for the aggregates
+   */
+  void AggregateBatch(const VectorBatch &batch, SimpleAggregationHashTable *ahts, size_t range_bits,
+                      std::vector<ColumnVector> *group_by_columns, std::vector<ColumnVector> *aggregate_columns);
+
+  /**
+   * Aggregate the input in parallel: each thread pre-aggregates the batches it produces into hash tables of its own,
+   * one per hash range, and each range is then merged into ranges_ by a single thread. A thread whose hash tables
+   * outgrow its share of the memory budget spills them, and then the merge happens partition by partition instead.
+   * @return `false` if the child does not run in parallel, and nothing was aggregated
+   */
+  bool ParallelAggregate();
+
+  /** @return the hash range of a group-by hash, out of 2^range_bits */
+  static size_t RangeOf(hash_t hash, size_t range_bits) {
+    hash_t mixed = hash * 0x9E3779B97F4A7C15ULL;
+    return range_bits == 0 ? 0 : mixed >> (sizeof(hash_t) * 8 - range_bits);
   }
 
-  /** @return The tuple as an AggregateValue */
-  AggregateValue MakeAggregateValue(const Tuple *tuple) {
-    std::vector<Value> vals;
-    for (const auto &expr : plan_->GetAggregates()) {
-      vals.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
-    }
-    return {vals};
+  /** The number of bits of the hash that select a partition at each level */
+  static constexpr size_t PARTITION_BITS = 4;
+  /** The number of partitions a spilled hash table or partition is split into */
+  static constexpr size_t NUM_PARTITIONS = 1 << PARTITION_BITS;
+  /** The number of times a partition is split before it is merged in memory regardless of its size */
+  static constexpr size_t MAX_LEVELS = 3;
+
+  /** A spilled partition of partial aggregates that hold the same hashes */
+  struct Partition {
+    std::unique_ptr<SpillFile> file_;
+    /** The number of times the partition has been split */
+    size_t level_;
+  };
+
+  /** @return the partition of a group-by hash at a level */
+  static size_t PartitionOf(hash_t hash, size_t level) {
+    // Mix the hash, and take the bits of each level from the top, where the bits of the whole hash end up.
+    hash_t mixed = hash * 0x9E3779B97F4A7C15ULL;
+    return (mixed >> (sizeof(hash_t) * 8 - PARTITION_BITS * (level + 1))) & (NUM_PARTITIONS - 1);
   }
 
+  /** Build spill_schema_, with a column for each group-by and each aggregate. */
+  void MakeSpillSchema();
+
+  /** Write the groups of a hash table to the partitions at level 0 and clear it. */
+  void SpillGroups(SimpleAggregationHashTable *aht);
+
+  /** Read a group back from a spilled tuple. */
+  void ReadGroup(const Tuple &tuple, AggregateKey *agg_key, AggregateValue *agg_val);
+
+  /** Split a partition that is too large to merge into NUM_PARTITIONS partitions at the next level. */
+  void Repartition(Partition *partition);
+
+  /**
+   * Merge the next spilled partition into aht_, which is cleared first.
+   * @return `false` if there are no more partitions
+   */
+  bool NextPartition();
+
  private:
   /** The aggregation plan node */
   const AggregationPlanNode *plan_;
@@ -213,5 +360,19 @@ class AggregationExecutor : public AbstractExecutor {
   /** Simple aggregation hash table iterator */
   SimpleAggregationHashTable::Iterator aht_iterator_;
   std::vector<Column> output_columns_;
+
+  /** The merged groups of a parallel aggregation, by hash range; empty if aht_ holds the groups */
+  std::vector<SimpleAggregationHashTable> ranges_;
+  /** The range being output */
+  size_t range_{0};
+
+  /** The schema of spilled groups: the group-bys, then the aggregates */
+  std::unique_ptr<Schema> spill_schema_;
+  /** True once the groups have been spilled, after which aht_ only ever holds a partition at a time */
+  bool spilled_{false};
+  /** The partitions left to merge */
+  std::vector<Partition> partitions_;
+  /** Serializes the threads that spill during a parallel aggregation */
+  std::mutex spill_latch_;
 };
 }  // namespace bustub
@@ -13,20 +13,27 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
+#include <mutex>  // NOLINT
 #include <utility>
 #include <vector>
 
 #include "common/util/hash_util.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/join_hash_table.h"
 #include "execution/plans/hash_join_plan.h"
+#include "execution/spill_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes an equi-JOIN on two tables with a hash table built over the left side.
+ *
+ * As long as the left side fits in the memory budget of the executor context, the join runs in memory. Once it does
+ * not, the join turns into a Grace hash join: both sides are partitioned by the hash of their join keys into spill
+ * files, and the partitions are then joined pairwise, each with a hash table of its own. A partition whose left side
+ * is still too large is partitioned again on other bits of the hash, up to MAX_LEVELS deep.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -40,7 +47,10 @@ class HashJoinExecutor : public AbstractExecutor {
   HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
                    std::unique_ptr<AbstractExecutor> &&left_child, std::unique_ptr<AbstractExecutor> &&right_child);
 
-  /** Initialize the join */
+  /**
+   * Initialize the join, building the hash table from the left side in parallel if the left side supports it. If
+   * the left side exceeds the memory budget, both sides are partitioned to spill files here.
+   */
   void Init() override;
 
   /**
@@ -51,20 +61,126 @@ class HashJoinExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of tuples from the join. The right side is consumed in batches, with its join keys
+   * evaluated a column at a time.
+   * @param[out] batch The next batch produced by the join
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(VectorBatch *batch) override;
+
+  /**
+   * Run the join in parallel, probing the hash table with the batches of the right side on the threads that
+   * produce them.
+   * @param consume the consumer of the batches produced by the join
+   * @return `true` if the join ran, `false` if parallelism is 1, the join spilled or the right side does not run in
+   * parallel
+   */
+  bool ParallelBatches(const std::function<void(size_t slot, VectorBatch *batch)> &consume) override;
+
   /** @return The output schema for the join */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
  private:
+  /** The number of bits of the hash that select a partition at each level */
+  static constexpr size_t PARTITION_BITS = 4;
+  /** The number of partitions a spilled input is split into at each level */
+  static constexpr size_t NUM_PARTITIONS = 1 << PARTITION_BITS;
+  /** The number of times a partition is split before it is joined in memory regardless of its size */
+  static constexpr size_t MAX_LEVELS = 3;
+
+  /** A pair of spilled partitions of the left and right side that hold the same hashes */
+  struct Partition {
+    std::unique_ptr<SpillFile> left_;
+    std::unique_ptr<SpillFile> right_;
+    /** The number of times the partition has been split */
+    size_t level_;
+  };
+
+  /** @return the partition a join key hash belongs to at a level */
+  static size_t PartitionOf(hash_t hash, size_t level) {
+    // Mix the hash, and take the bits of each level from the top, where the bits of the whole hash end up.
+    hash_t mixed = hash * 0x9E3779B97F4A7C15ULL;
+    return (mixed >> (sizeof(hash_t) * 8 - PARTITION_BITS * (level + 1))) & (NUM_PARTITIONS - 1);
+  }
+
+  /**
+   * Build the hash table from the left side in parallel: each thread hashes the rows it produces, and the rows are
+   * then inserted with InsertLeft() one batch at a time.
+   * @return `false` if the left side does not run in parallel, and nothing was inserted
+   */
+  bool ParallelBuild();
+
+  /** Insert a tuple of the left side into the hash table, or into its partition once the join has spilled. */
+  void InsertLeft(hash_t hash, const Value &key, Tuple &&tuple);
+
+  /** Partition the hash table to spill files, once it has outgrown the memory budget. */
+  void Spill();
+
+  /** @return a new pair of empty partitions */
+  Partition MakePartition(size_t level);
+
+  /** Split a pair of partitions one level further, and queue the resulting pairs. */
+  void Repartition(Partition *partition);
+
+  /**
+   * Build the hash table from the left side of the next queued pair of partitions, and probe it with the right side
+   * of the pair from then on.
+   * @return `false` if there are no more pairs with tuples on both sides
+   */
+  bool NextPartition();
+
+  /**
+   * Read the next batch of the right side into right_batch_, from the right child or, once the join has spilled,
+   * from the partitions.
+   * @return `false` if the right side is exhausted
+   */
+  bool NextRightBatch();
+
+  /**
+   * Move on to the next row of the right side whose key is in the hash table, and set right_tuple_, right_value_ and
+   * match_ for it.
+   * @return `false` if the right side is exhausted
+   */
+  bool NextRightRow();
+
+  /**
+   * Find the next tuple of the left side that joins with a tuple of the right side.
+   * @param[out] left_tuple the tuple of the left side, which joins with right_tuple_
+   * @return `false` if there are no more joined tuples
+   */
+  bool NextMatch(const Tuple **left_tuple);
+
+  /** Compute the output values of a pair of joined tuples. */
+  void JoinValues(const Tuple &left_tuple, const Tuple &right_tuple, std::vector<Value> *values);
+
   /** The NestedLoopJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> left_executor_;
   std::unique_ptr<AbstractExecutor> right_executor_;
-  std::unordered_map<hash_t, std::vector<Tuple>> ht_{};
-  std::vector<Tuple>::iterator tuple_iter_;
-  std::vector<Tuple>::iterator end_iter_;
+  JoinHashTable ht_;
+  /** Serializes the inserts of a parallel build */
+  std::mutex build_latch_;
+
+  /** True once the left side has outgrown the memory budget and the join works on partitions */
+  bool spilled_{false};
+  /** The pairs of partitions still to be joined */
+  std::vector<Partition> partitions_;
+  /** The right side of the pair of partitions being joined */
+  std::unique_ptr<SpillFile> right_partition_;
+
+  /** The current batch of the right side */
+  VectorBatch right_batch_;
+  /** The join keys of the rows of right_batch_ */
+  ColumnVector right_keys_;
+  /** The position of the current row of right_batch_ in its selection */
+  size_t right_pos_{0};
+  /** The current row of the right side */
   Tuple right_tuple_;
-  RID right_rid_;
+  /** The join key of right_tuple_ */
   Value right_value_;
+  /** The next tuple of the hash table that joins with right_tuple_, NO_ENTRY if there is none */
+  uint32_t match_{JoinHashTable::NO_ENTRY};
 };
 
 }  // namespace bustub
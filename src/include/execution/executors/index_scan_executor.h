@@ -18,14 +18,19 @@
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/index_scan_plan.h"
+#include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
  * IndexScanExecutor executes an index scan over a table.
+ *
+ * Over a B+ tree index, the scan seeks to the lower bound of the plan and walks the leaves in key order until it passes
+ * the upper bound, so that it reads only the keys in the range. A hash index has no key order: it serves a range that
+ * is a single key with one probe, and any other range by scanning the table. Either way, the tuples found are checked
+ * against the bounds and the predicate of the plan.
  */
-
 class IndexScanExecutor : public AbstractExecutor {
  public:
   /**
@@ -37,12 +42,50 @@ class IndexScanExecutor : public AbstractExecutor {
 
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
+  /** Initialize the scan, finding the RIDs of the keys in range if the index allows it. */
   void Init() override;
 
+  /**
+   * Yield the next tuple from the scan.
+   * @param[out] tuple The next tuple produced by the scan
+   * @param[out] rid The RID of the next tuple produced by the scan
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
   bool Next(Tuple *tuple, RID *rid) override;
 
  private:
+  /**
+   * Collect the RIDs of the keys in range, if the index is a B+ tree with keys of N bytes.
+   * @return `false` if the index is of another kind
+   */
+  template <size_t N>
+  bool ScanTree();
+
+  /**
+   * Collect the RIDs of the single key of the range, if the index is a hash index on one column and the range is a
+   * single key.
+   * @return `false` if the index cannot serve the range with a probe
+   */
+  bool ScanPoint();
+
+  /** @return true if a tuple of the table is in the key range and satisfies the predicate */
+  bool Matches(const Tuple &tuple) const;
+
+  /** Build the output tuple of a tuple of the table. */
+  void MakeOutput(const Tuple &table_tuple, Tuple *tuple, RID *rid) const;
+
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
+  const IndexInfo *index_info_{nullptr};
+  const TableInfo *table_info_{nullptr};
+  /** The column of the table that the leading column of the index key is built from */
+  uint32_t key_column_{0};
+
+  /** True if the index could not serve the range, and the table is scanned instead */
+  bool scan_table_{false};
+  TableIterator table_iter_;
+  /** The RIDs of the keys in range, in key order, and the position of the next one */
+  std::vector<RID> rids_;
+  size_t rid_pos_{0};
 };
 }  // namespace bustub
@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.h
+//
+// Identification: src/include/execution/executors/merge_join_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/merge_join_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * MergeJoinExecutor executes an equi-JOIN of two children that produce their tuples in ascending order of their join
+ * keys. Tuples with NULL keys join with nothing, and may come anywhere in that order.
+ *
+ * Both sides are read once, in batches, in step with each other. The right tuples of a run of equal keys are held in
+ * memory, so that every left tuple with that key joins with all of them; beyond that run, the join holds a batch of
+ * each side, whatever the size of the input.
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new MergeJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The merge join plan to be executed
+   * @param left_child The child executor that produces tuples for the left side of join
+   * @param right_child The child executor that produces tuples for the right side of join
+   */
+  MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&left_child, std::unique_ptr<AbstractExecutor> &&right_child);
+
+  /** Initialize the join */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join
+   * @param[out] rid The next tuple RID produced by the join
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /**
+   * Yield the next batch of tuples from the join.
+   * @param[out] batch The next batch produced by the join
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(VectorBatch *batch) override;
+
+  /** @return The output schema for the join */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+ private:
+  /** A position in the output of a child, with the join keys of the batch it is in */
+  struct Cursor {
+    AbstractExecutor *child_;
+    const AbstractExpression *key_expr_;
+    VectorBatch batch_;
+    ColumnVector keys_;
+    /** The position of the current row in the selection of batch_ */
+    size_t pos_{0};
+    /** True once the child has no more tuples */
+    bool done_{false};
+  };
+
+  /**
+   * Move a cursor to the first row at or after its position, reading batches from its child as needed.
+   * @return `false` if the child has no more tuples
+   */
+  bool Fill(Cursor *cursor);
+
+  /**
+   * Move a cursor to its next row.
+   * @return `false` if the child has no more tuples
+   */
+  bool Advance(Cursor *cursor) {
+    cursor->pos_++;
+    return Fill(cursor);
+  }
+
+  /** @return the join key of the current row of a cursor */
+  Value Key(const Cursor &cursor) const { return cursor.keys_.GetValue(cursor.batch_.GetSelection()[cursor.pos_]); }
+
+  /** @return the current row of a cursor as a tuple */
+  Tuple GetTuple(const Cursor &cursor) const {
+    return cursor.batch_.GetTuple(cursor.batch_.GetSelection()[cursor.pos_], cursor.child_->GetOutputSchema());
+  }
+
+  /**
+   * Find the next pair of joined tuples: left_tuple_, and the right tuple returned.
+   * @return the right tuple, or `nullptr` if there are no more joined tuples
+   */
+  const Tuple *NextMatch();
+
+  /** Compute the output values of a pair of joined tuples. */
+  void JoinValues(const Tuple &left_tuple, const Tuple &right_tuple, std::vector<Value> *values);
+
+  const MergeJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  Cursor left_;
+  Cursor right_;
+  /** The right tuples of the run of equal keys the current left tuple joins with */
+  std::vector<Tuple> right_run_;
+  /** The join key of right_run_ */
+  Value run_key_;
+  /** The position of the next tuple of right_run_ to join with left_tuple_ */
+  size_t run_pos_{0};
+  /** The current left tuple, once it has matched right_run_ */
+  Tuple left_tuple_;
+  /** True while left_tuple_, the current row of left_, is being joined with right_run_ */
+  bool left_matched_{false};
+};
+
+}  // namespace bustub
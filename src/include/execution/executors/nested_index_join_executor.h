@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 
+#include "catalog/catalog.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
@@ -29,6 +30,11 @@ namespace bustub {
 
 /**
  * IndexJoinExecutor executes index join operations.
+ *
+ * The outer side is read a batch at a time. The probe keys of a batch, computed by the left child of the predicate
+ * over the outer tuples, are sorted, so that the index is probed in key order and once per distinct key. The inner
+ * tuples the probes find are then fetched from the table sorted by RID, with each page fetched once for all its tuples.
+ * The predicate is evaluated over the joined tuples, which are produced in the order of their probe keys.
  */
 class NestIndexJoinExecutor : public AbstractExecutor {
  public:
@@ -47,8 +53,42 @@ class NestIndexJoinExecutor : public AbstractExecutor {
 
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of tuples from the join.
+   * @param[out] batch The next batch produced by the join
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(VectorBatch *batch) override;
+
  private:
+  /** A probe of the index by a row of the outer batch */
+  struct Probe {
+    /** The normalized probe key, from SortKeyUtil */
+    std::string sort_key_;
+    Value key_;
+    uint32_t row_;
+  };
+
+  /**
+   * Join the next batch of the outer side, filling output_ with the joined rows.
+   * @return `false` if the outer side has no more tuples
+   */
+  bool JoinNextBatch();
+
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
+  /** The child executor of the outer side */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  TableInfo *inner_table_info_{nullptr};
+  IndexInfo *index_info_{nullptr};
+
+  /** The batch of the outer side being joined */
+  VectorBatch outer_batch_;
+  /** The probe keys of outer_batch_ */
+  ColumnVector probe_keys_;
+  /** The output values of the joined rows of outer_batch_ */
+  std::vector<std::vector<Value>> output_;
+  /** The position of the next row of output_ to produce */
+  size_t output_pos_{0};
 };
 }  // namespace bustub
@@ -0,0 +1,159 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// radix_hash_join_executor.h
+//
+// Identification: src/include/execution/executors/radix_hash_join_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/join_hash_table.h"
+#include "execution/plans/hash_join_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * RadixHashJoinExecutor executes an equi-JOIN as a radix-partitioned hash join.
+ *
+ * Both sides are read in full, on several threads if they run in parallel, and scattered by the top bits of the hash
+ * of their join keys into partitions small enough that the hash table over a left partition stays in cache. Each
+ * thread scatters into partitions of its own, so partitioning shares no state. The pairs of partitions are then
+ * joined independently: serially by Next() and NextBatch(), or one pair per task by ParallelBatches().
+ *
+ * Unlike HashJoinExecutor, the join does not spill: both sides must fit in memory.
+ */
+class RadixHashJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new RadixHashJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The HashJoin join plan to be executed
+   * @param left_child The child executor that produces tuples for the left side of join
+   * @param right_child The child executor that produces tuples for the right side of join
+   */
+  RadixHashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
+                        std::unique_ptr<AbstractExecutor> &&left_child,
+                        std::unique_ptr<AbstractExecutor> &&right_child);
+
+  /** Initialize the join, reading and partitioning both sides */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join
+   * @param[out] rid The next tuple RID produced by the join
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /**
+   * Yield the next batch of tuples from the join.
+   * @param[out] batch The next batch produced by the join
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(VectorBatch *batch) override;
+
+  /**
+   * Join the pairs of partitions in parallel, one pair per task.
+   * @param consume the consumer of the batches produced by the join
+   * @return `true` if the join ran, `false` if parallelism is 1
+   */
+  bool ParallelBatches(const std::function<void(size_t slot, VectorBatch *batch)> &consume) override;
+
+  /** @return The output schema for the join */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+ private:
+  /** The number of bytes of left tuples a partition is aimed at, about the size of a per-core cache */
+  static constexpr size_t PARTITION_SIZE = 256 << 10;
+  /** The largest number of radix bits, which caps the number of partitions */
+  static constexpr size_t MAX_RADIX_BITS = 12;
+
+  /** A row of either side with its join key */
+  struct Row {
+    hash_t hash_;
+    Value key_;
+    Tuple tuple_;
+  };
+
+  /** The rows of one side, by the slot that read them and then by partition */
+  using Partitions = std::vector<std::vector<std::vector<Row>>>;
+
+  /** @return the partition of a join key hash */
+  size_t PartitionOf(hash_t hash) const {
+    // Mix the hash, and take the partition from its top bits; the join hash table uses other bits of the hash.
+    hash_t mixed = hash * 0x9E3779B97F4A7C15ULL;
+    return radix_bits_ == 0 ? 0 : mixed >> (sizeof(hash_t) * 8 - radix_bits_);
+  }
+
+  /**
+   * Read all rows of a side and compute the hashes of their join keys. Rows with a NULL key join with nothing and are
+   * dropped.
+   * @param child the executor of the side
+   * @param key the join key expression of the side
+   * @param schema the output schema of the child
+   * @param[out] rows the rows, by the slot that read them
+   */
+  void Gather(AbstractExecutor *child, const AbstractExpression *key, const Schema *schema,
+              std::vector<std::vector<Row>> *rows);
+
+  /** Build the hash table from the left rows of a partition, moving them out of the partition. */
+  void Build(size_t partition, JoinHashTable *ht);
+
+  /**
+   * Move on to the next right row that has a match, building the hash table of the next partition when the rows of
+   * the current one run out, and set right_row_ and match_ for it.
+   * @return `false` if there are no more right rows
+   */
+  bool NextRightRow();
+
+  /**
+   * Find the next pair of joined tuples.
+   * @param[out] left_tuple the tuple of the left side, which joins with right_row_
+   * @return `false` if there are no more joined tuples
+   */
+  bool NextMatch(const Tuple **left_tuple);
+
+  /** Compute the output values of a pair of joined tuples. */
+  void JoinValues(const Tuple &left_tuple, const Tuple &right_tuple, std::vector<Value> *values);
+
+  const HashJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  /** The number of top bits of the mixed hash that select a partition */
+  size_t radix_bits_{0};
+  size_t num_partitions_{1};
+  Partitions left_partitions_;
+  Partitions right_partitions_;
+
+  /** The partition being joined by Next() and NextBatch() */
+  size_t partition_{0};
+  /** The hash table over the left rows of partition_ */
+  JoinHashTable ht_;
+  /** True once ht_ has been built for partition_ */
+  bool built_{false};
+  /** The slot of the right rows of partition_ being probed */
+  size_t right_slot_{0};
+  /** The position of the next right row to probe within its slot */
+  size_t right_pos_{0};
+  /** The right row being joined */
+  const Row *right_row_{nullptr};
+  /** The next tuple of the hash table that joins with right_row_, NO_ENTRY if there is none */
+  uint32_t match_{JoinHashTable::NO_ENTRY};
+};
+
+}  // namespace bustub
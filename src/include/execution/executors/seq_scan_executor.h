@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>  // NOLINT
 #include <vector>
 
 #include "execution/executor_context.h"
@@ -44,13 +46,43 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of tuples from the sequential scan. The predicate is applied to whole columns at a time.
+   * @param[out] batch The next batch produced by the scan
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(VectorBatch *batch) override;
+
+  /**
+   * Run the scan in parallel, one morsel of the table per task.
+   * @param consume the consumer of the batches produced by the scan
+   * @return `true` if the scan ran, `false` if parallelism is 1
+   */
+  bool ParallelBatches(const std::function<void(size_t slot, VectorBatch *batch)> &consume) override;
+
   /** @return The output schema for the sequential scan */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); }
 
  private:
+  /**
+   * Read the next batch of tuples that satisfy the predicate and project them.
+   * @param iter the position of the scan, moved past the tuples read
+   * @param end the end of the scan
+   * @param scan_batch the batch to read the tuples into, before projection
+   * @param[out] batch the projected batch
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool ProduceBatch(TableIterator *iter, const TableIterator &end, VectorBatch *scan_batch, VectorBatch *batch);
+
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
   TableInfo *table_info_;
+  /** Keeps the scan from flushing the working set of other queries out of the buffer pool */
+  std::unique_ptr<BufferAccessStrategy> strategy_;
   TableIterator table_iter_;
+  /** The rows of the table read for the current batch, before projection */
+  VectorBatch scan_batch_;
+  /** Serializes the row locking of parallel scans, as the lock sets of a transaction are not thread-safe */
+  std::mutex lock_latch_;
 };
 }  // namespace bustub
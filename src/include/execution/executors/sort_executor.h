@@ -0,0 +1,124 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_executor.h
+//
+// Identification: src/include/execution/executors/sort_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/spill_file.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * SortExecutor executes an ORDER BY over the tuples produced by a child executor.
+ *
+ * Tuples are sorted by normalized keys from SortKeyUtil, which compare with a single memcmp(). As long as the tuples
+ * fit in the memory budget of the executor context, they are sorted in memory. Beyond it, each budget's worth of
+ * tuples is sorted and written out as a run to a spill file, and the runs are merged with a k-way merge, at most
+ * MERGE_FAN_IN runs at a time. The sort is stable: tuples with equal keys come out in the order the child produced
+ * them.
+ */
+class SortExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new SortExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The sort plan to be executed
+   * @param child_executor The child executor from which tuples are pulled
+   */
+  SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the sort, reading and sorting all tuples of the child */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the sort.
+   * @param[out] tuple The next tuple produced by the sort
+   * @param[out] rid The next tuple RID produced by the sort
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /**
+   * Yield the next batch of tuples from the sort.
+   * @param[out] batch The next batch produced by the sort
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(VectorBatch *batch) override;
+
+  /** @return The output schema for the sort */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+ private:
+  /** The largest number of runs merged at once; more runs are first merged into longer runs */
+  static constexpr size_t MERGE_FAN_IN = 32;
+
+  /** A tuple in memory with its sort key */
+  struct Entry {
+    std::string key_;
+    Tuple tuple_;
+  };
+
+  /** Sort the tuples in memory, keeping tuples with equal keys in order. */
+  void SortEntries();
+
+  /** Sort the tuples in memory and write them out as a run. */
+  void WriteRun();
+
+  /** Start a k-way merge of the first num_runs runs. */
+  void StartMerge(size_t num_runs);
+
+  /** @return `true` if the current tuple of run left comes after the one of run right in the merge */
+  bool MergesAfter(size_t left, size_t right) const;
+
+  /**
+   * Produce the next tuple of the merge.
+   * @param[out] tuple the tuple
+   * @return `false` if the merged runs are exhausted
+   */
+  bool NextMerged(Tuple *tuple);
+
+  /**
+   * Produce the next tuple of the sort, from memory or from the merge of the runs.
+   * @param[out] tuple the tuple
+   * @return `false` if there are no more tuples
+   */
+  bool NextTuple(Tuple *tuple);
+
+  /** The sort plan node to be executed */
+  const SortPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The tuples in memory, sorted once Init() is done if nothing was spilled */
+  std::vector<Entry> entries_;
+  /** The number of bytes the tuples in memory take up */
+  size_t size_{0};
+  /** The position of the next tuple of entries_ to output */
+  size_t pos_{0};
+
+  /** The sorted runs, in the order they were written */
+  std::vector<std::unique_ptr<SpillFile>> runs_;
+  /** The current tuple of each merged run, with its key */
+  std::vector<Entry> heads_;
+  /** A min-heap of the merged runs that are not exhausted, by the key of their current tuple and then their index */
+  std::vector<size_t> heap_;
+};
+
+}  // namespace bustub
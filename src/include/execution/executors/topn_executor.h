@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// topn_executor.h
+//
+// Identification: src/include/execution/executors/topn_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/topn_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TopNExecutor executes an ORDER BY ... LIMIT n over the tuples produced by a child executor.
+ *
+ * It keeps the n first tuples seen so far in a max-heap by their normalized sort keys from SortKeyUtil, so that it
+ * holds at most n tuples whatever the size of the input. A row whose key comes after the top of a full heap is
+ * discarded without its tuple being built. When the child runs in parallel, each thread keeps a heap of its own, and
+ * the heaps are combined at the end. Tuples with equal keys come out in the order the child produced them, when it
+ * runs serially.
+ */
+class TopNExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new TopNExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The top-n plan to be executed
+   * @param child_executor The child executor from which tuples are pulled
+   */
+  TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the top-n, reading all tuples of the child */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the top-n.
+   * @param[out] tuple The next tuple produced by the top-n
+   * @param[out] rid The next tuple RID produced by the top-n
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /**
+   * Yield the next batch of tuples from the top-n.
+   * @param[out] batch The next batch produced by the top-n
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(VectorBatch *batch) override;
+
+  /** @return The output schema for the top-n */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+ private:
+  /** A tuple kept in a heap, with its sort key and its position in the input of the heap */
+  struct Entry {
+    std::string key_;
+    size_t seq_;
+    Tuple tuple_;
+
+    /** @return true if this entry sorts before the other one */
+    bool operator<(const Entry &other) const {
+      int cmp = key_.compare(other.key_);
+      return cmp < 0 || (cmp == 0 && seq_ < other.seq_);
+    }
+  };
+
+  /** The heap of the tuples that sort first, of at most n entries, with the one that sorts last on top */
+  struct Heap {
+    std::vector<Entry> entries_;
+    /** The number of rows offered to the heap */
+    size_t seq_{0};
+    /** Scratch space for the keys of the batch being offered */
+    std::vector<ColumnVector> key_columns_;
+  };
+
+  /** Offer the rows of a batch to a heap. */
+  void OfferBatch(const VectorBatch &batch, Heap *heap);
+
+  /** The top-n plan node to be executed */
+  const TopNPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The top n tuples, in sort order once Init() is done */
+  std::vector<Entry> entries_;
+  /** The position of the next tuple of entries_ to output */
+  size_t pos_{0};
+};
+
+}  // namespace bustub
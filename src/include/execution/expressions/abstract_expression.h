@@ -16,7 +16,9 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "execution/vector_batch.h"
 #include "storage/table/tuple.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 /**
@@ -58,6 +60,41 @@ class AbstractExpression {
    */
   virtual Value EvaluateAggregate(const std::vector<Value> &group_bys, const std::vector<Value> &aggregates) const = 0;
 
+  /**
+   * Evaluate the expression on the selected rows of a batch. The default implementation builds a tuple for each row
+   * and calls Evaluate(); expressions that can work on whole columns override it.
+   * @param batch The batch
+   * @param schema The schema of the batch
+   * @param[out] result The value for each row of the batch; the values of unselected rows are unspecified
+   */
+  virtual void EvaluateBatch(const VectorBatch &batch, const Schema *schema, ColumnVector *result) const {
+    result->Reset(GetReturnType());
+    result->Resize(batch.NumRows());
+    for (auto row : batch.GetSelection()) {
+      Tuple tuple = batch.GetTuple(row, schema);
+      result->Set(row, Evaluate(&tuple, schema));
+    }
+  }
+
+  /**
+   * Narrow the selection of a batch down to the rows for which this boolean expression is true; NULL counts as false.
+   * @param[in,out] batch The batch
+   * @param schema The schema of the batch
+   */
+  virtual void FilterBatch(VectorBatch *batch, const Schema *schema) const {
+    ColumnVector result;
+    EvaluateBatch(*batch, schema, &result);
+    auto &selection = batch->GetSelection();
+    size_t num_selected = 0;
+    for (auto row : selection) {
+      Value value = result.GetValue(row);
+      if (!value.IsNull() && value.GetAs<bool>()) {
+        selection[num_selected++] = row;
+      }
+    }
+    selection.resize(num_selected);
+  }
+
   /** @return the child_idx'th child of this expression */
   const AbstractExpression *GetChildAt(uint32_t child_idx) const { return children_[child_idx]; }
 
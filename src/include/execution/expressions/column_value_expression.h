@@ -35,6 +35,10 @@ class ColumnValueExpression : public AbstractExpression {
 
   Value Evaluate(const Tuple *tuple, const Schema *schema) const override { return tuple->GetValue(schema, col_idx_); }
 
+  void EvaluateBatch(const VectorBatch &batch, const Schema *schema, ColumnVector *result) const override {
+    *result = batch.GetColumn(col_idx_);
+  }
+
   Value EvaluateJoin(const Tuple *left_tuple, const Schema *left_schema, const Tuple *right_tuple,
                      const Schema *right_schema) const override {
     return tuple_idx_ == 0 ? left_tuple->GetValue(left_schema, col_idx_)
@@ -12,12 +12,16 @@
 
 #pragma once
 
+#include <functional>
 #include <utility>
 #include <vector>
 
 #include "catalog/schema.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
 #include "storage/table/tuple.h"
+#include "type/limits.h"
 #include "type/value_factory.h"
 
 namespace bustub {
@@ -32,14 +36,69 @@ class ComparisonExpression : public AbstractExpression {
  public:
   /** Creates a new comparison expression representing (left comp_type right). */
   ComparisonExpression(const AbstractExpression *left, const AbstractExpression *right, ComparisonType comp_type)
-      : AbstractExpression({left, right}, TypeId::BOOLEAN), comp_type_{comp_type} {}
+      : AbstractExpression({left, right}, TypeId::BOOLEAN), comp_type_{comp_type} {
+    is_integer_comparison_ =
+        ToIntegerOperand(left, &integer_operands_[0]) && ToIntegerOperand(right, &integer_operands_[1]);
+  }
+
+  /** @return the type of the comparison */
+  ComparisonType GetComparisonType() const { return comp_type_; }
 
   Value Evaluate(const Tuple *tuple, const Schema *schema) const override {
+    // Compare integer columns and constants straight from the tuple bytes; NULLs take the general path.
+    int32_t lhs_integer;
+    int32_t rhs_integer;
+    if (is_integer_comparison_ && ReadInteger(integer_operands_[0], tuple, schema, &lhs_integer) &&
+        ReadInteger(integer_operands_[1], tuple, schema, &rhs_integer)) {
+      return ValueFactory::GetBooleanValue(PerformComparison(lhs_integer, rhs_integer));
+    }
     Value lhs = GetChildAt(0)->Evaluate(tuple, schema);
     Value rhs = GetChildAt(1)->Evaluate(tuple, schema);
     return ValueFactory::GetBooleanValue(PerformComparison(lhs, rhs));
   }
 
+  void EvaluateBatch(const VectorBatch &batch, const Schema *schema, ColumnVector *result) const override {
+    ColumnVector lhs;
+    ColumnVector rhs;
+    GetChildAt(0)->EvaluateBatch(batch, schema, &lhs);
+    GetChildAt(1)->EvaluateBatch(batch, schema, &rhs);
+    result->Reset(TypeId::BOOLEAN);
+    result->Resize(batch.NumRows());
+    for (auto row : batch.GetSelection()) {
+      result->Set(row, ValueFactory::GetBooleanValue(PerformComparison(lhs.GetValue(row), rhs.GetValue(row))));
+    }
+  }
+
+  void FilterBatch(VectorBatch *batch, const Schema *schema) const override {
+    // Compare integer columns and constants with a tight loop over their raw values. A constant is read through a
+    // stride of 0, so that the same loop serves columns and constants.
+    const int32_t *lhs;
+    const int32_t *rhs;
+    size_t lhs_stride;
+    size_t rhs_stride;
+    if (!is_integer_comparison_ || !GetIntegers(integer_operands_[0], *batch, &lhs, &lhs_stride) ||
+        !GetIntegers(integer_operands_[1], *batch, &rhs, &rhs_stride)) {
+      AbstractExpression::FilterBatch(batch, schema);
+      return;
+    }
+    switch (comp_type_) {
+      case ComparisonType::Equal:
+        return FilterIntegers(batch, lhs, lhs_stride, rhs, rhs_stride, std::equal_to<>());
+      case ComparisonType::NotEqual:
+        return FilterIntegers(batch, lhs, lhs_stride, rhs, rhs_stride, std::not_equal_to<>());
+      case ComparisonType::LessThan:
+        return FilterIntegers(batch, lhs, lhs_stride, rhs, rhs_stride, std::less<>());
+      case ComparisonType::LessThanOrEqual:
+        return FilterIntegers(batch, lhs, lhs_stride, rhs, rhs_stride, std::less_equal<>());
+      case ComparisonType::GreaterThan:
+        return FilterIntegers(batch, lhs, lhs_stride, rhs, rhs_stride, std::greater<>());
+      case ComparisonType::GreaterThanOrEqual:
+        return FilterIntegers(batch, lhs, lhs_stride, rhs, rhs_stride, std::greater_equal<>());
+      default:
+        BUSTUB_ASSERT(false, "Unsupported comparison type.");
+    }
+  }
+
   Value EvaluateJoin(const Tuple *left_tuple, const Schema *left_schema, const Tuple *right_tuple,
                      const Schema *right_schema) const override {
     Value lhs = GetChildAt(0)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
@@ -54,6 +113,95 @@ class ComparisonExpression : public AbstractExpression {
   }
 
  private:
+  /** An operand of an integer comparison: either an integer column or a non-NULL integer constant. */
+  struct IntegerOperand {
+    bool is_column_;
+    uint32_t col_idx_;
+    int32_t constant_;
+  };
+
+  /** @return true if expr is an operand of an integer comparison, which is then stored in operand */
+  static bool ToIntegerOperand(const AbstractExpression *expr, IntegerOperand *operand) {
+    if (auto column = dynamic_cast<const ColumnValueExpression *>(expr); column != nullptr) {
+      *operand = {true, column->GetColIdx(), 0};
+      return true;
+    }
+    if (auto constant = dynamic_cast<const ConstantValueExpression *>(expr); constant != nullptr) {
+      Value value = constant->Evaluate(nullptr, nullptr);
+      if (value.GetTypeId() == TypeId::INTEGER && !value.IsNull()) {
+        *operand = {false, 0, value.GetAs<int32_t>()};
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** @return true if the operand was read as a non-NULL integer into value */
+  static bool ReadInteger(const IntegerOperand &operand, const Tuple *tuple, const Schema *schema, int32_t *value) {
+    if (!operand.is_column_) {
+      *value = operand.constant_;
+      return true;
+    }
+    if (schema->GetAccessor(operand.col_idx_).type_ != TypeId::INTEGER) {
+      return false;
+    }
+    *value = tuple->GetAs<int32_t>(schema, operand.col_idx_);
+    return *value != BUSTUB_INT32_NULL;
+  }
+
+  /** @return true if the operand is available as raw integers in the batch, which are then stored in values */
+  static bool GetIntegers(const IntegerOperand &operand, const VectorBatch &batch, const int32_t **values,
+                          size_t *stride) {
+    if (!operand.is_column_) {
+      *values = &operand.constant_;
+      *stride = 0;
+      return true;
+    }
+    if (!batch.GetColumn(operand.col_idx_).IsInteger()) {
+      return false;
+    }
+    *values = batch.GetColumn(operand.col_idx_).GetIntegers();
+    *stride = 1;
+    return true;
+  }
+
+  /** Keep the selected rows of the batch for which compare is true on the non-NULL operands. */
+  template <typename Compare>
+  static void FilterIntegers(VectorBatch *batch, const int32_t *lhs, size_t lhs_stride, const int32_t *rhs,
+                             size_t rhs_stride, Compare compare) {
+    auto &selection = batch->GetSelection();
+    size_t num_selected = 0;
+    for (auto row : selection) {
+      int32_t lhs_value = lhs[row * lhs_stride];
+      int32_t rhs_value = rhs[row * rhs_stride];
+      // Write the row unconditionally and only advance past it if it passes, which keeps the loop free of branches.
+      selection[num_selected] = row;
+      num_selected += static_cast<size_t>(static_cast<int>(lhs_value != BUSTUB_INT32_NULL) &
+                                          static_cast<int>(rhs_value != BUSTUB_INT32_NULL) &
+                                          static_cast<int>(compare(lhs_value, rhs_value)));
+    }
+    selection.resize(num_selected);
+  }
+
+  CmpBool PerformComparison(int32_t lhs, int32_t rhs) const {
+    switch (comp_type_) {
+      case ComparisonType::Equal:
+        return GetCmpBool(lhs == rhs);
+      case ComparisonType::NotEqual:
+        return GetCmpBool(lhs != rhs);
+      case ComparisonType::LessThan:
+        return GetCmpBool(lhs < rhs);
+      case ComparisonType::LessThanOrEqual:
+        return GetCmpBool(lhs <= rhs);
+      case ComparisonType::GreaterThan:
+        return GetCmpBool(lhs > rhs);
+      case ComparisonType::GreaterThanOrEqual:
+        return GetCmpBool(lhs >= rhs);
+      default:
+        BUSTUB_ASSERT(false, "Unsupported comparison type.");
+    }
+  }
+
   CmpBool PerformComparison(const Value &lhs, const Value &rhs) const {
     switch (comp_type_) {
       case ComparisonType::Equal:
@@ -75,5 +223,8 @@ class ComparisonExpression : public AbstractExpression {
 
   std::vector<const AbstractExpression *> children_;
   ComparisonType comp_type_;
+  /** True if both operands are integer columns or constants. */
+  bool is_integer_comparison_;
+  IntegerOperand integer_operands_[2];
 };
 }  // namespace bustub
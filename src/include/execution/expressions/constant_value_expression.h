@@ -27,6 +27,13 @@ class ConstantValueExpression : public AbstractExpression {
 
   Value Evaluate(const Tuple *tuple, const Schema *schema) const override { return val_; }
 
+  void EvaluateBatch(const VectorBatch &batch, const Schema *schema, ColumnVector *result) const override {
+    result->Reset(val_.GetTypeId());
+    for (size_t row = 0; row < batch.NumRows(); row++) {
+      result->Append(val_);
+    }
+  }
+
   Value EvaluateJoin(const Tuple *left_tuple, const Schema *left_schema, const Tuple *right_tuple,
                      const Schema *right_schema) const override {
     return val_;
@@ -0,0 +1,56 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_bounds.h
+//
+// Identification: src/include/execution/index_bounds.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/index_scan_plan.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * IndexBoundsUtil derives the key range of an index scan from its predicate, and tests keys against such a range.
+ */
+class IndexBoundsUtil {
+ public:
+  /**
+   * Derive the bounds of a column from the conjuncts of a predicate. Each conjunct that compares the column with a
+   * non-NULL constant, as `col op const` or `const op col` with op one of =, <, <=, > and >=, tightens the bounds;
+   * other conjuncts are left to the predicate.
+   * @param conjuncts the expressions that all must hold
+   * @param col_idx the index of the column in the table schema, i.e. the leading column of the index key
+   * @param[in,out] lower the lower bound of the column, tightened in place
+   * @param[in,out] upper the upper bound of the column, tightened in place
+   * @return true if any conjunct bounded the column
+   */
+  static bool DeriveBounds(const std::vector<const AbstractExpression *> &conjuncts, uint32_t col_idx,
+                           std::optional<IndexKeyBound> *lower, std::optional<IndexKeyBound> *upper);
+
+  /** @return true if a key is not below a lower bound */
+  static bool IsAboveLower(const Value &key, const std::optional<IndexKeyBound> &lower);
+
+  /** @return true if a key is not beyond an upper bound */
+  static bool IsBelowUpper(const Value &key, const std::optional<IndexKeyBound> &upper);
+
+ private:
+  /** Tighten a lower bound to a key, if the key is the tighter bound. */
+  static void TightenLower(const Value &key, bool inclusive, std::optional<IndexKeyBound> *lower);
+
+  /** Tighten an upper bound to a key, if the key is the tighter bound. */
+  static void TightenUpper(const Value &key, bool inclusive, std::optional<IndexKeyBound> *upper);
+};
+
+}  // namespace bustub
@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table.h
+//
+// Identification: src/include/execution/join_hash_table.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * JoinHashTable is the hash table of a hash join: a multimap from join keys to the tuples of the build side.
+ *
+ * It is a flat, open-addressing table with linear probing, with one slot per distinct key. The slots are split in two
+ * arrays: a byte per slot holding a tag of 7 bits of the hash, and the slots proper, holding the full hash, the index
+ * of the key and the index of the first tuple with that key. A probe scans the tags and only looks at a slot whose tag
+ * matches, and only compares the keys once the full hashes match, so that mismatches cost about a byte each. The keys
+ * and the tuples live in arenas; the tuples of a key are chained through the tuple arena, and all of them join with a
+ * probe that matches the key, without their join key being evaluated again.
+ */
+class JoinHashTable {
+ public:
+  /** The index of no tuple, which ends a chain */
+  static constexpr uint32_t NO_ENTRY = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * Insert a tuple. Tuples with a NULL join key join with nothing and are dropped.
+   * @param hash the hash of the join key of the tuple, from HashUtil::HashValue()
+   * @param key the join key of the tuple
+   * @param tuple the tuple
+   */
+  void Insert(hash_t hash, const Value &key, Tuple &&tuple);
+
+  /**
+   * Find the tuples with a join key.
+   * @param hash the hash of the key, from HashUtil::HashValue()
+   * @param key the key
+   * @return the first tuple with the key, which leads to the others through Next(), or NO_ENTRY if there is none
+   */
+  uint32_t Find(hash_t hash, const Value &key) const;
+
+  /** @return the tuple after entry with the same join key, or NO_ENTRY if entry is the last one */
+  uint32_t Next(uint32_t entry) const { return next_[entry]; }
+
+  /** @return the tuple of an entry */
+  const Tuple &GetTuple(uint32_t entry) const { return tuples_[entry]; }
+
+  /**
+   * Visit every tuple of the table.
+   * @param visit called with the hash of the join key of each tuple, and the tuple
+   */
+  void ForEach(const std::function<void(hash_t hash, const Tuple &tuple)> &visit) const;
+
+  /** @return true if the table holds no tuples */
+  bool IsEmpty() const { return tuples_.empty(); }
+
+  /** @return the number of bytes of tuple data in the table */
+  size_t GetSize() const { return size_; }
+
+  /** Remove all tuples. */
+  void Clear();
+
+ private:
+  /** A slot of the table, for one distinct join key */
+  struct Slot {
+    hash_t hash_;
+    uint32_t key_;
+    uint32_t head_;
+  };
+
+  /** Tags of empty slots */
+  static constexpr uint8_t EMPTY = 0;
+
+  /** @return the hash, with its bits mixed so that both the slot index and the tag are well distributed */
+  static hash_t Mix(hash_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  /** @return the tag of a mixed hash, which is never EMPTY */
+  static uint8_t Tag(hash_t mixed) { return static_cast<uint8_t>(mixed >> (sizeof(hash_t) * 8 - 7)) | 0x80; }
+
+  /** Double the number of slots. */
+  void Grow();
+
+  /** Put a slot into the first free slot of its probe sequence. */
+  void Place(const Slot &slot);
+
+  /** The tag of each slot, EMPTY for an empty one */
+  std::vector<uint8_t> tags_;
+  std::vector<Slot> slots_;
+  /** The distinct join keys */
+  std::vector<Value> keys_;
+  /** The tuples, with the index of the next tuple with the same key */
+  std::vector<Tuple> tuples_;
+  std::vector<uint32_t> next_;
+  size_t size_{0};
+};
+
+}  // namespace bustub
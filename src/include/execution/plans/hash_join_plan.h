@@ -19,6 +19,17 @@
 
 namespace bustub {
 
+/** The physical operators that can execute a hash join. */
+enum class HashJoinAlgorithm {
+  /** A hash table over the left side, probed by the right side, which spills to disk beyond the memory budget */
+  Simple,
+  /**
+   * Both sides partitioned by hash into cache-sized partitions, with the partition pairs joined independently and in
+   * parallel; for very large joins that fit in memory
+   */
+  RadixPartitioned,
+};
+
 /**
  * Hash join performs a JOIN operation with a hash table.
  */
@@ -30,12 +41,15 @@ class HashJoinPlanNode : public AbstractPlanNode {
    * @param children The child plans from which tuples are obtained
    * @param left_key_expression The expression for the left JOIN key
    * @param right_key_expression The expression for the right JOIN key
+   * @param algorithm The physical operator to execute the JOIN with
    */
   HashJoinPlanNode(const Schema *output_schema, std::vector<const AbstractPlanNode *> &&children,
-                   const AbstractExpression *left_key_expression, const AbstractExpression *right_key_expression)
+                   const AbstractExpression *left_key_expression, const AbstractExpression *right_key_expression,
+                   HashJoinAlgorithm algorithm = HashJoinAlgorithm::Simple)
       : AbstractPlanNode(output_schema, std::move(children)),
         left_key_expression_{left_key_expression},
-        right_key_expression_{right_key_expression} {}
+        right_key_expression_{right_key_expression},
+        algorithm_{algorithm} {}
 
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::HashJoin; }
@@ -46,6 +60,9 @@ class HashJoinPlanNode : public AbstractPlanNode {
   /** @return The expression to compute the right join key */
   const AbstractExpression *RightJoinKeyExpression() const { return right_key_expression_; }
 
+  /** @return The physical operator to execute the JOIN with */
+  HashJoinAlgorithm GetAlgorithm() const { return algorithm_; }
+
   /** @return The left plan node of the hash join */
   const AbstractPlanNode *GetLeftPlan() const {
     BUSTUB_ASSERT(GetChildren().size() == 2, "Hash joins should have exactly two children plans.");
@@ -63,6 +80,8 @@ class HashJoinPlanNode : public AbstractPlanNode {
   const AbstractExpression *left_key_expression_;
   /** The expression to compute the right JOIN key */
   const AbstractExpression *right_key_expression_;
+  /** The physical operator to execute the JOIN with */
+  HashJoinAlgorithm algorithm_;
 };
 
 }  // namespace bustub
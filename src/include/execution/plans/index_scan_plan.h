@@ -12,13 +12,29 @@
 
 #pragma once
 
+#include <optional>
+#include <utility>
+
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
 
 namespace bustub {
+
+/**
+ * IndexKeyBound is one end of the range of keys an index scan reads: a value of the leading column of the index key,
+ * and whether keys equal to it are in the range.
+ */
+struct IndexKeyBound {
+  Value key_;
+  bool inclusive_;
+};
+
 /**
  * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
+ *
+ * The scan may be limited to a range of the leading column of the index key. The predicate is still applied to every
+ * tuple in the range, so the bounds only need to hold the tuples that satisfy it.
  */
 class IndexScanPlanNode : public AbstractPlanNode {
  public:
@@ -28,9 +44,17 @@ class IndexScanPlanNode : public AbstractPlanNode {
    * @param predicate the predicate to scan with, tuples are returned if predicate(tuple) == true or predicate ==
    * nullptr
    * @param table_oid the identifier of table to be scanned
+   * @param lower the lower bound of the leading key column, or none to scan from the first key
+   * @param upper the upper bound of the leading key column, or none to scan to the last key
    */
-  IndexScanPlanNode(const Schema *output, const AbstractExpression *predicate, index_oid_t index_oid)
-      : AbstractPlanNode(output, {}), predicate_{predicate}, index_oid_(index_oid) {}
+  IndexScanPlanNode(const Schema *output, const AbstractExpression *predicate, index_oid_t index_oid,
+                    std::optional<IndexKeyBound> lower = std::nullopt,
+                    std::optional<IndexKeyBound> upper = std::nullopt)
+      : AbstractPlanNode(output, {}),
+        predicate_{predicate},
+        index_oid_(index_oid),
+        lower_{std::move(lower)},
+        upper_{std::move(upper)} {}
 
   PlanType GetType() const override { return PlanType::IndexScan; }
 
@@ -40,11 +64,20 @@ class IndexScanPlanNode : public AbstractPlanNode {
   /** @return the identifier of the table that should be scanned */
   index_oid_t GetIndexOid() const { return index_oid_; }
 
+  /** @return the lower bound of the leading key column, if any */
+  const std::optional<IndexKeyBound> &GetLowerBound() const { return lower_; }
+
+  /** @return the upper bound of the leading key column, if any */
+  const std::optional<IndexKeyBound> &GetUpperBound() const { return upper_; }
+
  private:
   /** The predicate that all returned tuples must satisfy. */
   const AbstractExpression *predicate_;
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
+  /** The bounds of the leading key column of the keys to scan. */
+  std::optional<IndexKeyBound> lower_;
+  std::optional<IndexKeyBound> upper_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_plan.h
+//
+// Identification: src/include/execution/plans/sort_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/** The direction of an ORDER BY key. NULLs sort before all values in ascending order, and after them in descending. */
+enum class OrderByType { Asc, Desc };
+
+/** An ORDER BY key: its direction and the expression that computes it over the child's output */
+using OrderBy = std::pair<OrderByType, const AbstractExpression *>;
+
+/**
+ * Sort performs an ORDER BY over the output of a child node. Its output schema is the output schema of the child.
+ */
+class SortPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new SortPlanNode instance.
+   * @param output_schema The output schema of the sort, which is the output schema of the child
+   * @param child The child plan from which tuples are obtained
+   * @param order_bys The ORDER BY keys, from the most significant one
+   */
+  SortPlanNode(const Schema *output_schema, const AbstractPlanNode *child, std::vector<OrderBy> order_bys)
+      : AbstractPlanNode(output_schema, {child}), order_bys_(std::move(order_bys)) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::Sort; }
+
+  /** @return The ORDER BY keys, from the most significant one */
+  const std::vector<OrderBy> &GetOrderBys() const { return order_bys_; }
+
+  /** @return The child plan node */
+  const AbstractPlanNode *GetChildPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Sort should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+ private:
+  /** The ORDER BY keys */
+  std::vector<OrderBy> order_bys_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// topn_plan.h
+//
+// Identification: src/include/execution/plans/topn_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/sort_plan.h"
+
+namespace bustub {
+
+/**
+ * TopN performs an ORDER BY ... LIMIT n over the output of a child node: it produces the first n tuples of the child
+ * in sort order. Its output schema is the output schema of the child.
+ */
+class TopNPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new TopNPlanNode instance.
+   * @param output_schema The output schema of the top-n, which is the output schema of the child
+   * @param child The child plan from which tuples are obtained
+   * @param order_bys The ORDER BY keys, from the most significant one
+   * @param n The number of tuples to produce
+   */
+  TopNPlanNode(const Schema *output_schema, const AbstractPlanNode *child, std::vector<OrderBy> order_bys,
+               std::size_t n)
+      : AbstractPlanNode(output_schema, {child}), order_bys_(std::move(order_bys)), n_{n} {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::TopN; }
+
+  /** @return The ORDER BY keys, from the most significant one */
+  const std::vector<OrderBy> &GetOrderBys() const { return order_bys_; }
+
+  /** @return The number of tuples to produce */
+  size_t GetN() const { return n_; }
+
+  /** @return The child plan node */
+  const AbstractPlanNode *GetChildPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "TopN should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+ private:
+  /** The ORDER BY keys */
+  std::vector<OrderBy> order_bys_;
+  /** The number of tuples to produce */
+  std::size_t n_;
+};
+
+}  // namespace bustub
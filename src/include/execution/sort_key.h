@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.h
+//
+// Identification: src/include/execution/sort_key.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "execution/plans/sort_plan.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * SortKeyUtil builds normalized sort keys: byte strings that compare with memcmp() in the order of the values they
+ * encode, so that sorting compares keys of any number of columns and types with a single memcmp().
+ *
+ * Each value is encoded as a byte that sorts NULL first, followed, for non-NULL values, by an encoding of the value:
+ * integers and timestamps big-endian with the sign bit flipped, decimals by the bits of the double with either the sign
+ * bit or all bits flipped, and varchars by their bytes, with zero bytes escaped as 0x00 0xFF and the string ended by
+ * 0x00 0x00, so that a string sorts before the strings it is a prefix of. All bytes of a descending value are inverted.
+ * Values of the same column must have the same type.
+ */
+class SortKeyUtil {
+ public:
+  /**
+   * Append the encoding of a value to a sort key.
+   * @param value the value
+   * @param order the direction of the value in the sort order
+   * @param[out] key the key to append to
+   */
+  static void AppendValue(const Value &value, OrderByType order, std::string *key);
+
+  /**
+   * Build the sort key of a tuple.
+   * @param tuple the tuple
+   * @param schema the schema of the tuple
+   * @param order_bys the ORDER BY keys, from the most significant one
+   * @param[out] key the sort key, which is cleared first
+   */
+  static void MakeKey(const Tuple &tuple, const Schema *schema, const std::vector<OrderBy> &order_bys,
+                      std::string *key);
+
+ private:
+  /** Append the low bytes of an unsigned integer, most significant first. */
+  static void AppendBigEndian(uint64_t bits, size_t num_bytes, std::string *key);
+};
+
+}  // namespace bustub
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_file.h
+//
+// Identification: src/include/execution/spill_file.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * SpillFile is a temporary sequence of tuples that executors write out when their intermediate results do not fit in
+ * their memory budget, and read back in the order they were written.
+ *
+ * Tuples are gathered in a TmpTuplePage outside the buffer pool, and only go through the buffer pool, one full page at
+ * a time, once that page is full. A spill file that never fills a page thus causes no I/O, and writing to many spill
+ * files at once, e.g. one per partition, pins no pages. The pages of the file are deleted along with it.
+ */
+class SpillFile {
+ public:
+  /**
+   * Create an empty spill file.
+   * @param bpm the buffer pool manager to write the pages of the file through
+   */
+  explicit SpillFile(BufferPoolManager *bpm);
+
+  /** Delete the pages of the file. */
+  ~SpillFile();
+
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /**
+   * Append a tuple to the file. Throws an OUT_OF_MEMORY exception if the buffer pool has no frame to write a page
+   * through.
+   * @param tuple the tuple, which must fit in a page
+   */
+  void Append(const Tuple &tuple);
+
+  /** @return the number of tuples in the file */
+  size_t GetNumTuples() const { return num_tuples_; }
+
+  /** @return the number of bytes of tuple data in the file */
+  size_t GetSize() const { return size_; }
+
+  /**
+   * Read the next tuple of the file. Once reading has started, no more tuples may be appended until Rewind(), which
+   * starts reading over from the first tuple.
+   * @param[out] tuple the next tuple
+   * @return true if a tuple was read, false if there are no more tuples
+   */
+  bool Next(Tuple *tuple);
+
+  /** Start reading the file from its first tuple again. */
+  void Rewind();
+
+ private:
+  /** Write the page being filled through the buffer pool and start a new one. */
+  void FlushPage();
+
+  /** Read the tuples of a page into read_tuples_, in the order they were written. */
+  void LoadPage(TmpTuplePage *page);
+
+  BufferPoolManager *bpm_;
+  /** The full pages of the file, in order */
+  std::vector<page_id_t> page_ids_;
+  /** The page being filled, which follows the pages of page_ids_ */
+  std::unique_ptr<TmpTuplePage> write_page_;
+  size_t num_tuples_{0};
+  size_t size_{0};
+
+  /** The index of the next page to read, page_ids_.size() standing for write_page_ */
+  size_t read_page_{0};
+  /** The tuples of the page being read */
+  std::vector<Tuple> read_tuples_;
+  /** The position of the next tuple of read_tuples_ to read */
+  size_t read_pos_{0};
+};
+
+}  // namespace bustub
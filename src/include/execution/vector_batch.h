@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// vector_batch.h
+//
+// Identification: src/include/execution/vector_batch.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * ColumnVector holds the values of one column for the rows of a batch. INTEGER columns are stored as raw int32_t
+ * values (NULL as BUSTUB_INT32_NULL) so that vectorized kernels can work on them directly; all other columns are
+ * stored as Values.
+ */
+class ColumnVector {
+ public:
+  /**
+   * Create an empty column.
+   * @param type the type of the values in the column
+   */
+  explicit ColumnVector(TypeId type = TypeId::INVALID) { Reset(type); }
+
+  /** Empty the column and set the type of its values. */
+  void Reset(TypeId type) {
+    type_ = type;
+    is_integer_ = type == TypeId::INTEGER;
+    integers_.clear();
+    values_.clear();
+  }
+
+  /** @return the type of the values in the column */
+  TypeId GetType() const { return type_; }
+
+  /** @return true if the column is stored as raw integers, see GetIntegers() */
+  bool IsInteger() const { return is_integer_; }
+
+  /** @return the number of rows in the column */
+  size_t Size() const { return is_integer_ ? integers_.size() : values_.size(); }
+
+  /** Set the number of rows in the column; new rows are NULL. */
+  void Resize(size_t size);
+
+  /** Append a value to the column. */
+  void Append(const Value &value);
+
+  /** Append a raw value to an integer column. */
+  void AppendInteger(int32_t value) { integers_.emplace_back(value); }
+
+  /** Set the value of a row of the column. */
+  void Set(size_t row, const Value &value);
+
+  /** @return the value of a row of the column */
+  Value GetValue(size_t row) const;
+
+  /** @return the raw values of an integer column, indexed by row */
+  const int32_t *GetIntegers() const { return integers_.data(); }
+
+ private:
+  /** Switch the column from raw integers to Values, so that it can hold a value of another type. */
+  void ToValues();
+
+  TypeId type_;
+  bool is_integer_;
+  std::vector<int32_t> integers_;
+  std::vector<Value> values_;
+};
+
+/**
+ * VectorBatch is the unit of data passed between vectorized executors: a set of column vectors holding up to
+ * VECTOR_BATCH_SIZE rows, together with the RID of each row and a selection vector. Only the rows listed in the
+ * selection vector, in ascending order, are part of the batch; filters narrow the selection down instead of copying
+ * the rows that pass.
+ */
+class VectorBatch {
+ public:
+  /** Empty the batch and give it one column for each column of schema. */
+  void Reset(const Schema *schema);
+
+  /** @return the number of columns of the batch */
+  uint32_t GetColumnCount() const { return static_cast<uint32_t>(columns_.size()); }
+
+  /** @return the column at col_idx */
+  const ColumnVector &GetColumn(uint32_t col_idx) const { return columns_[col_idx]; }
+
+  /** @return the column at col_idx */
+  ColumnVector &GetColumn(uint32_t col_idx) { return columns_[col_idx]; }
+
+  /** @return the number of rows in the batch, selected or not */
+  size_t NumRows() const { return rids_.size(); }
+
+  /** @return true if no more rows can be appended */
+  bool IsFull() const { return NumRows() >= VECTOR_BATCH_SIZE; }
+
+  /** @return the number of selected rows */
+  size_t NumSelected() const { return selection_.size(); }
+
+  /** @return the selected rows, in ascending order */
+  const std::vector<uint32_t> &GetSelection() const { return selection_; }
+
+  /** @return the selected rows, in ascending order */
+  std::vector<uint32_t> &GetSelection() { return selection_; }
+
+  /** @return the RID of every row */
+  const std::vector<RID> &GetRids() const { return rids_; }
+
+  /** @return the RID of every row */
+  std::vector<RID> &GetRids() { return rids_; }
+
+  /**
+   * Append a row holding the columns of a tuple, and select it.
+   * @param tuple the tuple
+   * @param rid the RID of the row
+   * @param schema the schema of both the tuple and the batch
+   */
+  void AppendTuple(const Tuple &tuple, const RID &rid, const Schema *schema);
+
+  /**
+   * Append a row holding the given values, one per column, and select it.
+   * @param values the values
+   * @param rid the RID of the row
+   */
+  void AppendValues(const std::vector<Value> &values, const RID &rid);
+
+  /**
+   * Build a tuple from a row of the batch.
+   * @param row the row
+   * @param schema the schema of the batch
+   * @return the tuple, with the RID of the row
+   */
+  Tuple GetTuple(size_t row, const Schema *schema) const;
+
+ private:
+  std::vector<ColumnVector> columns_;
+  std::vector<RID> rids_;
+  std::vector<uint32_t> selection_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,149 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// async_disk_io.h
+//
+// Identification: src/include/storage/disk/async_disk_io.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <future>  // NOLINT
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/**
+ * AsyncDiskIO lets a caller keep many page reads and writes of a DiskManager's database file in flight at once.
+ * Each submission returns a future that becomes ready when the I/O has completed: poll it with wait_for() or block on
+ * it with get(). The page buffer must stay valid, and untouched by anyone else, until then.
+ *
+ * Reads past the end of the file and writes are accounted exactly as DiskManager::ReadPage and WritePage do.
+ */
+class AsyncDiskIO {
+ public:
+  /**
+   * Creates the best backend available: io_uring on Linux kernels that support it, a thread pool otherwise.
+   * @param disk_manager the disk manager whose database file is accessed
+   * @param queue_depth the maximum number of I/Os in flight, further submissions block until one completes
+   * @return the new backend
+   */
+  static std::unique_ptr<AsyncDiskIO> Create(DiskManager *disk_manager, size_t queue_depth = ASYNC_IO_QUEUE_DEPTH);
+
+  AsyncDiskIO() = default;
+  virtual ~AsyncDiskIO() = default;
+
+  DISALLOW_COPY_AND_MOVE(AsyncDiskIO);
+
+  /**
+   * Submit the read of a page.
+   * @param page_id id of the page
+   * @param[out] page_data output buffer
+   * @return a future that is true once the page is in page_data, false if the read failed
+   */
+  virtual std::future<bool> SubmitRead(page_id_t page_id, char *page_data) = 0;
+
+  /**
+   * Submit the write of a page.
+   * @param page_id id of the page
+   * @param page_data raw page data
+   * @return a future that is true once the page is written, false if the write failed
+   */
+  virtual std::future<bool> SubmitWrite(page_id_t page_id, const char *page_data) = 0;
+};
+
+/**
+ * AsyncDiskIO backend that hands each I/O to a pool of threads doing the blocking DiskManager calls.
+ */
+class ThreadPoolDiskIO : public AsyncDiskIO {
+ public:
+  /**
+   * Creates a new ThreadPoolDiskIO.
+   * @param disk_manager the disk manager whose database file is accessed
+   * @param num_threads the number of I/Os in flight at once
+   */
+  ThreadPoolDiskIO(DiskManager *disk_manager, size_t num_threads);
+
+  /** Completes the pending I/Os and joins the threads. */
+  ~ThreadPoolDiskIO() override;
+
+  std::future<bool> SubmitRead(page_id_t page_id, char *page_data) override;
+
+  std::future<bool> SubmitWrite(page_id_t page_id, const char *page_data) override;
+
+ private:
+  struct Request {
+    bool is_write_;
+    page_id_t page_id_;
+    char *page_data_;
+    std::promise<bool> promise_;
+  };
+
+  std::future<bool> Submit(bool is_write, page_id_t page_id, char *page_data);
+
+  DiskManager *disk_manager_;
+  std::vector<std::thread> threads_;
+  /** Protects queue_ and running_. */
+  std::mutex latch_;
+  std::condition_variable cv_;
+  std::deque<Request> queue_;
+  bool running_ = true;
+};
+
+/**
+ * AsyncDiskIO backend on a Linux io_uring. Submissions go straight to the kernel, and a completion thread reaps the
+ * completion queue and fulfills the futures.
+ */
+class IoUringDiskIO : public AsyncDiskIO {
+ public:
+  /**
+   * Creates a new IoUringDiskIO.
+   * @param disk_manager the disk manager whose database file is accessed
+   * @param queue_depth the maximum number of I/Os in flight
+   * @throws Exception if io_uring is not available
+   */
+  IoUringDiskIO(DiskManager *disk_manager, size_t queue_depth);
+
+  /** Completes the pending I/Os, stops the completion thread and tears down the ring. */
+  ~IoUringDiskIO() override;
+
+  std::future<bool> SubmitRead(page_id_t page_id, char *page_data) override;
+
+  std::future<bool> SubmitWrite(page_id_t page_id, const char *page_data) override;
+
+ private:
+  struct Request;
+  struct Ring;
+
+  std::future<bool> Submit(bool is_write, page_id_t page_id, char *page_data);
+
+  /** Body of the completion thread. */
+  void ReapCompletions();
+
+  DiskManager *disk_manager_;
+  /** The mapped submission and completion queues, hidden so that the kernel header stays out of this one. */
+  std::unique_ptr<Ring> ring_;
+  const size_t queue_depth_;
+  /** Protects the submission queue, in_flight_ and running_. */
+  std::mutex latch_;
+  /** Signalled when an I/O completes. */
+  std::condition_variable cv_;
+  size_t in_flight_ = 0;
+  bool running_ = true;
+  std::thread reaper_;
+};
+
+}  // namespace bustub
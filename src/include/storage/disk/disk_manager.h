@@ -12,11 +12,13 @@
 
 #pragma once
 
+#include <sys/types.h>
 #include <atomic>
 #include <fstream>
-#include <future>  // NOLINT
-#include <mutex>   // NOLINT
+#include <future>        // NOLINT
+#include <shared_mutex>  // NOLINT
 #include <string>
+#include <vector>
 
 #include "common/config.h"
 
@@ -25,19 +27,30 @@ namespace bustub {
 /**
  * DiskManager takes care of the allocation and deallocation of pages within a database. It performs the reading and
  * writing of pages to and from disk, providing a logical file layer within the context of a database management system.
+ *
+ * Pages are read and written with positional I/O on the database file, so ReadPage and WritePage may be called
+ * concurrently (e.g. by the instances of a parallel buffer pool) without serializing on a shared file cursor.
+ *
+ * The database is either one file or, when created with a segment size, a series of segment files holding
+ * pages_per_segment pages each: the database file itself, then db_file.1, db_file.2 and so on. Segments are created
+ * when a page in them is first written.
  */
 class DiskManager {
+  friend class IoUringDiskIO;
+
  public:
   /**
    * Creates a new disk manager that writes to the specified database file.
    * @param db_file the file name of the database file to write to
+   * @param pages_per_segment the number of pages in each segment file, 0 to keep the database in a single file
    */
-  explicit DiskManager(const std::string &db_file);
+  explicit DiskManager(const std::string &db_file, size_t pages_per_segment = 0);
 
-  ~DiskManager() = default;
+  /** Closes the database file if ShutDown() was not called. */
+  ~DiskManager();
 
   /**
-   * Shut down the disk manager and close all the file resources.
+   * Shut down the disk manager and close all the file resources. Pages can no longer be read or written afterwards.
    */
   void ShutDown();
 
@@ -69,7 +82,7 @@ class DiskManager {
    * @param offset offset of the log entry in the file
    * @return true if the read was successful, false otherwise
    */
-  bool ReadLog(char *log_data, int size, int offset);
+  bool ReadLog(char *log_data, int size, int64_t offset);
 
   /** @return the number of disk flushes */
   int GetNumFlushes() const;
@@ -90,19 +103,41 @@ class DiskManager {
   inline bool HasFlushLogFuture() { return flush_log_f_ != nullptr; }
 
  private:
-  int GetFileSize(const std::string &file_name);
+  int64_t GetFileSize(const std::string &file_name);
+
+  /** @return the file name of a segment of the database */
+  std::string GetSegmentName(size_t segment) const {
+    return segment == 0 ? file_name_ : file_name_ + "." + std::to_string(segment);
+  }
+
+  /**
+   * Find where a page is stored, opening its segment file if needed.
+   * @param page_id id of the page
+   * @param create true to create the segment file if it does not exist
+   * @param[out] offset the offset of the page in its segment file
+   * @return the file descriptor of the segment file, -1 if it does not exist and create is false, or if the disk
+   * manager was shut down
+   */
+  int GetSegment(page_id_t page_id, bool create, off_t *offset);
+
   // stream to write log file
   std::fstream log_io_;
   std::string log_name_;
-  // stream to write db file
-  std::fstream db_io_;
+  // db_fds_ entry of a segment file that was found not to exist
+  static constexpr int MISSING_SEGMENT = -2;
+  // file descriptors of the db segment files, -1 for a segment that is not open, MISSING_SEGMENT for one that does not
+  // exist yet
+  std::vector<int> db_fds_;
+  // true once ShutDown() was called; page I/O then fails instead of reopening the segment files
+  bool shut_down_{false};
+  // protects db_fds_ and shut_down_; page I/O only takes it shared
+  std::shared_mutex db_fds_latch_;
   std::string file_name_;
+  const size_t pages_per_segment_;
   int num_flushes_;
-  int num_writes_;
+  std::atomic<int> num_writes_;
   bool flush_log_;
   std::future<void> *flush_log_f_;
-  // With multiple buffer pool instances, need to protect file access
-  std::mutex db_io_latch_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_page.h
+//
+// Identification: src/include/storage/page/free_space_map_page.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "storage/page/page.h"
+
+namespace bustub {
+
+/**
+ * A page of the free-space map of a table. It records, for a run of the table's pages, how much space each of them has
+ * left, rounded down to a one-byte category of FSM_CATEGORY_SIZE bytes. The pages of a map form a singly-linked list,
+ * and table pages are recorded in the order they were added to the table.
+ *
+ * Format (size in byte):
+ *  --------------------------------------------------------------------------------------------------------
+ * | NextPageId (4) | EntryCount (4) | PageId_1 (4) | ... | PageId_CAPACITY (4) | Category_1 (1) | ... |
+ *  --------------------------------------------------------------------------------------------------------
+ */
+class FreeSpaceMapPage : public Page {
+ public:
+  /** Number of bytes of free space per category. */
+  static constexpr uint32_t FSM_CATEGORY_SIZE = PAGE_SIZE / 256;
+  /** Number of table pages recorded in one map page. */
+  static constexpr size_t CAPACITY = (PAGE_SIZE - 8) / (sizeof(page_id_t) + 1);
+
+  /** Initialize an empty map page. */
+  void Init() {
+    SetNextPageId(INVALID_PAGE_ID);
+    SetEntryCount(0);
+  }
+
+  /** @return the page ID of the next page of the map */
+  page_id_t GetNextPageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_NEXT_PAGE_ID); }
+
+  /** Set the page ID of the next page of the map. */
+  void SetNextPageId(page_id_t next_page_id) {
+    memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
+  }
+
+  /** @return the number of table pages recorded in this page */
+  uint32_t GetEntryCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_ENTRY_COUNT); }
+
+  /** Set the number of table pages recorded in this page. */
+  void SetEntryCount(uint32_t entry_count) { memcpy(GetData() + OFFSET_ENTRY_COUNT, &entry_count, sizeof(uint32_t)); }
+
+  /** @return the table page recorded at the given index */
+  page_id_t GetPageId(uint32_t index) {
+    return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_PAGE_IDS + sizeof(page_id_t) * index);
+  }
+
+  /** Record a table page at the given index. */
+  void SetPageId(uint32_t index, page_id_t page_id) {
+    memcpy(GetData() + OFFSET_PAGE_IDS + sizeof(page_id_t) * index, &page_id, sizeof(page_id_t));
+  }
+
+  /** @return the free-space category of the table page at the given index */
+  uint8_t GetCategory(uint32_t index) { return *reinterpret_cast<uint8_t *>(GetData() + OFFSET_CATEGORIES + index); }
+
+  /** Set the free-space category of the table page at the given index. */
+  void SetCategory(uint32_t index, uint8_t category) { GetData()[OFFSET_CATEGORIES + index] = category; }
+
+  /** @return the category of a page with free_space bytes left, rounded down so that it never overstates the space */
+  static uint8_t ToCategory(uint32_t free_space) {
+    return static_cast<uint8_t>(std::min<uint32_t>(free_space / FSM_CATEGORY_SIZE, UINT8_MAX));
+  }
+
+  /** @return the smallest category whose pages are guaranteed to have required_space bytes left */
+  static uint32_t ToRequiredCategory(uint32_t required_space) {
+    return (required_space + FSM_CATEGORY_SIZE - 1) / FSM_CATEGORY_SIZE;
+  }
+
+ private:
+  static_assert(sizeof(page_id_t) == 4);
+
+  static constexpr size_t OFFSET_NEXT_PAGE_ID = 0;
+  static constexpr size_t OFFSET_ENTRY_COUNT = 4;
+  static constexpr size_t OFFSET_PAGE_IDS = 8;
+  static constexpr size_t OFFSET_CATEGORIES = OFFSET_PAGE_IDS + sizeof(page_id_t) * CAPACITY;
+};
+
+}  // namespace bustub
@@ -72,6 +72,24 @@ class TablePage : public Page {
     memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
   }
 
+  /**
+   * The first page of a table has no previous page, so its PrevPageId field holds the root page of the table's
+   * free-space map instead.
+   * @return the page ID of the free-space map of the table, INVALID_PAGE_ID if it has none yet
+   */
+  page_id_t GetFreeSpaceMapPageId() { return GetPrevPageId(); }
+
+  /** Set the page id of the free-space map of the table. Only valid on the first page of a table. */
+  void SetFreeSpaceMapPageId(page_id_t fsm_page_id) { SetPrevPageId(fsm_page_id); }
+
+  /** @return the number of bytes left for new tuples, counting their slot */
+  uint32_t GetFreeSpaceRemaining() {
+    return GetFreeSpacePointer() - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE * GetTupleCount();
+  }
+
+  /** @return the free space a page needs for the tuple to be inserted into it */
+  static uint32_t GetRequiredSpace(const Tuple &tuple) { return tuple.GetLength() + SIZE_TUPLE; }
+
   /**
    * Insert a tuple into the table.
    * @param tuple tuple to insert
@@ -122,6 +140,16 @@ class TablePage : public Page {
    */
   bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager);
 
+  /**
+   * Read a tuple from a table without copying it.
+   * @param rid rid of the tuple to read
+   * @param[out] tuple a view of the tuple, valid only while the page is pinned and its contents unchanged
+   * @param txn transaction performing the read
+   * @param lock_manager the lock manager
+   * @return true if the read is successful (i.e. the tuple exists)
+   */
+  bool GetTupleView(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager);
+
   /** @return the rid of the first tuple in this page */
 
   /**
@@ -166,10 +194,6 @@ class TablePage : public Page {
   /** Set the number of tuples in this page. */
   void SetTupleCount(uint32_t tuple_count) { memcpy(GetData() + OFFSET_TUPLE_COUNT, &tuple_count, sizeof(uint32_t)); }
 
-  uint32_t GetFreeSpaceRemaining() {
-    return GetFreeSpacePointer() - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE * GetTupleCount();
-  }
-
   /** @return tuple offset at slot slot_num */
   uint32_t GetTupleOffsetAtSlot(uint32_t slot_num) {
     return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_TUPLE_OFFSET + SIZE_TUPLE * slot_num);
@@ -1,15 +1,13 @@
 #pragma once
 
+#include <cstring>
+
 #include "storage/page/page.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
-// To pass the test cases for this class, you must follow the existing TmpTuplePage format and implement the
-// existing functions exactly as they are! It may be helpful to look at TablePage.
-// Remember that this task is optional, you get full credit if you finish the next task.
-
 /**
  * TmpTuplePage format:
  *
@@ -17,17 +15,99 @@ namespace bustub {
  * | PageId (4) | LSN (4) | FreeSpace (4) | (free space) | TupleSize2 | TupleData2 | TupleSize1 | TupleData1 |
  *
  * We choose this format because DeserializeExpression expects to read Size followed by Data.
+ *
+ * FreeSpace is the offset at which the free space ends, i.e. the offset of the last tuple inserted. A tuple is
+ * addressed by the offset of its size field, so that it can be read back with Tuple::DeserializeFrom().
+ * Temporary pages hold the intermediate results of executors; they are not logged, and tuples are never deleted from
+ * them.
  */
 class TmpTuplePage : public Page {
  public:
-  void Init(page_id_t page_id, uint32_t page_size) {}
+  /**
+   * Initialize an empty page.
+   * @param page_id the id of the page
+   * @param page_size the size of the page
+   */
+  void Init(page_id_t page_id, uint32_t page_size) {
+    SetTablePageId(page_id);
+    memcpy(GetData() + OFFSET_LSN, &INVALID_LSN_VALUE, sizeof(lsn_t));
+    SetFreeSpacePointer(page_size);
+  }
+
+  /** @return the id of the page */
+  page_id_t GetTablePageId() { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  /** Set the id of the page, e.g. once the contents of a page built outside the buffer pool are copied into it. */
+  void SetTablePageId(page_id_t page_id) { memcpy(GetData(), &page_id, sizeof(page_id_t)); }
+
+  /** @return true if the page holds no tuples */
+  bool IsEmpty() { return GetFreeSpacePointer() == PAGE_SIZE; }
 
-  page_id_t GetTablePageId() { return INVALID_PAGE_ID; }
+  /**
+   * Insert a tuple into the page.
+   * @param tuple the tuple
+   * @param[out] out the location of the tuple
+   * @return true if the insert succeeded, false if there is not enough free space left
+   */
+  bool Insert(const Tuple &tuple, TmpTuple *out) {
+    uint32_t size = sizeof(uint32_t) + tuple.GetLength();
+    uint32_t free_space_pointer = GetFreeSpacePointer();
+    if (free_space_pointer < SIZE_HEADER + size) {
+      return false;
+    }
+    free_space_pointer -= size;
+    tuple.SerializeTo(GetData() + free_space_pointer);
+    SetFreeSpacePointer(free_space_pointer);
+    *out = TmpTuple(GetTablePageId(), free_space_pointer);
+    return true;
+  }
 
-  bool Insert(const Tuple &tuple, TmpTuple *out) { return false; }
+  /**
+   * Read a tuple of the page.
+   * @param tmp_tuple the location of the tuple
+   * @param[out] tuple the tuple
+   */
+  void Get(const TmpTuple &tmp_tuple, Tuple *tuple) { tuple->DeserializeFrom(GetData() + tmp_tuple.GetOffset()); }
+
+  /**
+   * @param[out] first the location of the tuple inserted last, which comes first in the page
+   * @return true if the page holds a tuple, false otherwise
+   */
+  bool GetFirstTmpTuple(TmpTuple *first) {
+    if (IsEmpty()) {
+      return false;
+    }
+    *first = TmpTuple(GetTablePageId(), GetFreeSpacePointer());
+    return true;
+  }
+
+  /**
+   * @param cur the location of the current tuple
+   * @param[out] next the location of the tuple inserted before the current one, which follows it in the page
+   * @return true if the next tuple exists, false otherwise
+   */
+  bool GetNextTmpTuple(const TmpTuple &cur, TmpTuple *next) {
+    size_t offset = cur.GetOffset() + sizeof(uint32_t) + *reinterpret_cast<uint32_t *>(GetData() + cur.GetOffset());
+    if (offset >= PAGE_SIZE) {
+      return false;
+    }
+    *next = TmpTuple(GetTablePageId(), offset);
+    return true;
+  }
 
  private:
   static_assert(sizeof(page_id_t) == 4);
+
+  static constexpr size_t OFFSET_LSN = 4;
+  static constexpr size_t OFFSET_FREE_SPACE = 8;
+  static constexpr size_t SIZE_HEADER = 12;
+  static constexpr lsn_t INVALID_LSN_VALUE = INVALID_LSN;
+
+  uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
+
+  void SetFreeSpacePointer(uint32_t free_space_pointer) {
+    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
+  }
 };
 
 }  // namespace bustub
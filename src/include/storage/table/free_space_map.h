@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map.h
+//
+// Identification: src/include/storage/table/free_space_map.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "storage/page/free_space_map_page.h"
+
+namespace bustub {
+
+/**
+ * FreeSpaceMap tracks how much room each page of a table has left, so that an insert can go straight to a page that
+ * fits the tuple instead of walking the page chain. The map is persisted in FreeSpaceMapPages and mirrored in memory
+ * for searching. It is a hint: a page may have more space than recorded, and concurrent inserters may take the space
+ * a page was found with, so the caller always reports the actual space back.
+ *
+ * Inserters claim the page they are given until they release it, and searches skip claimed pages. Concurrent inserters
+ * are thus spread over different pages, extending the table if need be, instead of piling up on one page latch.
+ *
+ * The unclaimed pages are indexed by category, so that a search goes straight to the fullest page with enough room
+ * without looking at the others. The map pages are only fetched outside the latch of the map, so that buffer pool I/O
+ * never holds up the searches of other inserters.
+ */
+class FreeSpaceMap {
+ public:
+  /**
+   * Creates a new, empty free-space map.
+   * @param buffer_pool_manager the buffer pool manager the map is stored in
+   */
+  explicit FreeSpaceMap(BufferPoolManager *buffer_pool_manager);
+
+  /**
+   * Opens an existing free-space map.
+   * @param buffer_pool_manager the buffer pool manager the map is stored in
+   * @param root_page_id the first page of the map
+   */
+  FreeSpaceMap(BufferPoolManager *buffer_pool_manager, page_id_t root_page_id);
+
+  /** @return the first page of the map */
+  page_id_t GetRootPageId() const { return fsm_page_ids_.front(); }
+
+  /** @return all the table pages, in the order they were added, which is their order in the table */
+  std::vector<page_id_t> GetPageIds();
+
+  /** @return the table page added last, INVALID_PAGE_ID if there is none */
+  page_id_t GetLastPageId();
+
+  /**
+   * Record a page that was just added to the table.
+   * @param page_id the new table page
+   * @param free_space the free space the page has left
+   * @param claim true to claim the page for the caller, as FindPage() would
+   * @return false if the page could not be recorded because the map page could not be fetched
+   */
+  bool AddPage(page_id_t page_id, uint32_t free_space, bool claim);
+
+  /**
+   * Find a page with room for an insert and claim it. The caller must call ReleasePage() once it is done with it.
+   * @param required_space the free space the insert needs
+   * @return the claimed page, INVALID_PAGE_ID if no unclaimed page is known to have that much room
+   */
+  page_id_t FindPage(uint32_t required_space);
+
+  /**
+   * Release a page claimed with FindPage() or AddPage(). Its free space must have been recorded with UpdatePage().
+   * @param page_id the claimed page
+   */
+  void ReleasePage(page_id_t page_id);
+
+  /**
+   * Record the free space of a page after it changed. If the map page cannot be fetched, only the copy in memory is
+   * updated.
+   * @param page_id the table page
+   * @param free_space the free space the page has left
+   */
+  void UpdatePage(page_id_t page_id, uint32_t free_space);
+
+ private:
+  /** The number of free-space categories */
+  static constexpr size_t NUM_CATEGORIES = UINT8_MAX + 1;
+
+  /**
+   * Set the category of the page at a slot in memory, moving it in the index if it is not claimed. The caller must
+   * hold latch_.
+   * @return true if the category changed, and must be written to its map page with WriteCategory()
+   */
+  bool SetCategory(size_t slot, uint8_t category);
+
+  /** Write the category the page at a slot has in memory to its map page. The caller must not hold latch_. */
+  void WriteCategory(size_t slot);
+
+  BufferPoolManager *buffer_pool_manager_;
+  /** Serializes AddPage(), which fetches map pages without holding latch_. */
+  std::mutex add_latch_;
+  /** Protects all the members below. A map page latch may be taken before it, but never after it. */
+  std::mutex latch_;
+  /** The pages of the map, in list order. */
+  std::vector<page_id_t> fsm_page_ids_;
+  /** The table page recorded at each slot; slot i is entry i % CAPACITY of map page i / CAPACITY. */
+  std::vector<page_id_t> page_ids_;
+  /** The free-space category of the table page at each slot. */
+  std::vector<uint8_t> categories_;
+  /** The slot of each table page. */
+  std::unordered_map<page_id_t, size_t> slots_;
+  /** The pages claimed by inserters. */
+  std::unordered_set<page_id_t> claimed_;
+  /** The slots of the unclaimed pages, by category. */
+  std::array<std::set<size_t>, NUM_CATEGORIES> free_slots_;
+};
+
+}  // namespace bustub
@@ -12,9 +12,14 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
+#include "storage/table/free_space_map.h"
 #include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
 
@@ -22,7 +27,7 @@ namespace bustub {
 
 /**
  * TableHeap represents a physical table on disk.
- * This is just a doubly-linked list of pages.
+ * This is just a doubly-linked list of pages, with a free-space map that inserts use to find a page with room.
  */
 class TableHeap {
   friend class TableIterator;
@@ -99,20 +104,67 @@ class TableHeap {
    */
   bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn);
 
-  /** @return the begin iterator of this table */
-  TableIterator Begin(Transaction *txn);
+  /**
+   * Read several tuples from the table, fetching a page once for all the tuples on it that come one after the other.
+   * @param rids rids of the tuples to read, best sorted so that the tuples of a page are together
+   * @param[out] tuples the tuples that could be read, in the order of their rids, each with its rid
+   * @param txn transaction performing the read
+   * @return false if a page could not be fetched, in which case the transaction is aborted
+   */
+  bool GetTuples(const std::vector<RID> &rids, std::vector<Tuple> *tuples, Transaction *txn);
+
+  /**
+   * @param txn the transaction performing the scan
+   * @param strategy the buffer access strategy to fetch the pages of the table with, nullptr for regular fetches
+   * @return the begin iterator of this table
+   */
+  TableIterator Begin(Transaction *txn, BufferAccessStrategy *strategy = nullptr);
 
   /** @return the end iterator of this table */
   TableIterator End();
 
+  /** A run of consecutive pages of the table, the unit of work of a parallel scan. */
+  struct Morsel {
+    /** The first page of the morsel */
+    page_id_t first_page_id_;
+    /** The page after the last page of the morsel, INVALID_PAGE_ID if the morsel runs to the end of the table */
+    page_id_t end_page_id_;
+  };
+
+  /**
+   * Split the table into morsels. Pages added to the table later belong to the last morsel.
+   * @param pages_per_morsel the number of pages in each morsel but the last
+   * @return the morsels, in table order
+   */
+  std::vector<Morsel> GetMorsels(size_t pages_per_morsel);
+
+  /**
+   * @param morsel a morsel of this table
+   * @param txn the transaction performing the scan
+   * @param strategy the buffer access strategy to fetch the pages of the table with, nullptr for regular fetches
+   * @return an iterator over the tuples of the morsel, which equals End() once it has passed them all
+   */
+  TableIterator Begin(const Morsel &morsel, Transaction *txn, BufferAccessStrategy *strategy = nullptr);
+
   /** @return the id of the first page of this table */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
  private:
+  /**
+   * Create a new page at the end of the table and claim it in the free-space map.
+   * @param txn the transaction creating the page
+   * @return the id of the new page, INVALID_PAGE_ID if it could not be created
+   */
+  page_id_t AppendPage(Transaction *txn);
+
   BufferPoolManager *buffer_pool_manager_;
   LockManager *lock_manager_;
   LogManager *log_manager_;
   page_id_t first_page_id_{};
+  /** The free space of the pages of this table. */
+  std::unique_ptr<FreeSpaceMap> fsm_;
+  /** Serializes adding pages at the end of the table. */
+  std::mutex append_latch_;
 };
 
 }  // namespace bustub
@@ -13,7 +13,10 @@
 #pragma once
 
 #include <cassert>
+#include <memory>
+#include <vector>
 
+#include "buffer/buffer_access_strategy.h"
 #include "common/rid.h"
 #include "concurrency/transaction.h"
 #include "storage/table/tuple.h"
@@ -24,19 +27,26 @@ class TableHeap;
 
 /**
  * TableIterator enables the sequential scan of a TableHeap.
+ *
+ * The iterator works a page at a time: when it enters a page, it fetches and latches the page once and copies it into
+ * a buffer, and the live tuples of the page are then handed out as views into that buffer without going back to the
+ * buffer pool. A scan thus costs one fetch, one latch and one copy per page rather than per tuple. The tuples handed
+ * out are only valid until the iterator moves to the next page; use Tuple::Materialize() to keep one for longer.
  */
 class TableIterator {
-  friend class Cursor;
-
  public:
-  TableIterator(TableHeap *table_heap, RID rid, Transaction *txn);
-
-  TableIterator(const TableIterator &other)
-      : table_heap_(other.table_heap_), tuple_(new Tuple(*other.tuple_)), txn_(other.txn_) {}
-
-  ~TableIterator() { delete tuple_; }
-
-  inline bool operator==(const TableIterator &itr) const { return tuple_->rid_.Get() == itr.tuple_->rid_.Get(); }
+  /**
+   * Create an iterator starting at a tuple.
+   * @param table_heap the table
+   * @param rid the tuple to start at; if it does not exist, the iterator starts at the next one
+   * @param txn the transaction performing the scan
+   * @param strategy the buffer access strategy to fetch the pages of the table with, nullptr for regular fetches
+   * @param end_page_id the page to stop at, INVALID_PAGE_ID to scan to the end of the table
+   */
+  TableIterator(TableHeap *table_heap, RID rid, Transaction *txn, BufferAccessStrategy *strategy = nullptr,
+                page_id_t end_page_id = INVALID_PAGE_ID);
+
+  inline bool operator==(const TableIterator &itr) const { return GetCurrentRid().Get() == itr.GetCurrentRid().Get(); }
 
   inline bool operator!=(const TableIterator &itr) const { return !(*this == itr); }
 
@@ -48,17 +58,32 @@ class TableIterator {
 
   TableIterator operator++(int);
 
-  TableIterator &operator=(const TableIterator &other) {
-    table_heap_ = other.table_heap_;
-    *tuple_ = *other.tuple_;
-    txn_ = other.txn_;
-    return *this;
-  }
-
  private:
+  /** @return the RID of the current tuple, RID(INVALID_PAGE_ID, 0) at the end of the table */
+  RID GetCurrentRid() const { return cursor_ < tuples_.size() ? tuples_[cursor_].GetRid() : RID(INVALID_PAGE_ID, 0); }
+
+  /**
+   * Read the live tuples of the first page from page_id on that has any, starting at start_slot of page_id. If there
+   * is no such page, the iterator is at the end of the table.
+   */
+  void LoadPage(page_id_t page_id, uint32_t start_slot);
+
   TableHeap *table_heap_;
-  Tuple *tuple_;
   Transaction *txn_;
+  /** The buffer access strategy the pages of the table are fetched with, nullptr for regular fetches. */
+  BufferAccessStrategy *strategy_;
+  /**
+   * The copy of the current page the tuples point into; a new buffer is allocated if a copy of the iterator holds it.
+   */
+  std::shared_ptr<char[]> page_data_;
+  /** Views of the live tuples of the current page, in slot order. */
+  std::vector<Tuple> tuples_;
+  /** The index of the current tuple in tuples_. */
+  size_t cursor_{0};
+  /** The page after the current page. */
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  /** The page the iterator stops at. */
+  page_id_t end_page_id_;
 };
 
 }  // namespace bustub
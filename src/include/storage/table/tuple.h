@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <cassert>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -22,6 +24,11 @@
 namespace bustub {
 
 /**
+ * A Tuple either owns a heap-allocated copy of its bytes or is a view: a non-owning tuple whose bytes live elsewhere,
+ * e.g. in a pinned page or in a scan's page buffer. Views are cheap to create and copy (copies are views of the same
+ * bytes) and are evaluated like any other tuple, but they are only valid as long as the bytes they point to; a view
+ * that must outlive them has to be turned into an owning tuple with Materialize().
+ *
  * Tuple format:
  * ---------------------------------------------------------------------
  * | FIXED-SIZE or VARIED-SIZED OFFSET | PAYLOAD OF VARIED-SIZED FIELD |
@@ -31,6 +38,7 @@ class Tuple {
   friend class TablePage;
   friend class TableHeap;
   friend class TableIterator;
+  friend class VectorBatch;
 
  public:
   // Default constructor (to create a dummy tuple)
@@ -39,15 +47,24 @@ class Tuple {
   // constructor for table heap tuple
   explicit Tuple(RID rid) : rid_(rid) {}
 
+  // constructor for a view of tuple data stored elsewhere, which must outlive the view
+  Tuple(RID rid, char *data, uint32_t size) : rid_(rid), size_(size), data_(data) {}
+
   // constructor for creating a new tuple based on input value
   Tuple(std::vector<Value> values, const Schema *schema);
 
-  // copy constructor, deep copy
+  // copy constructor, deep copy (shallow for a view)
   Tuple(const Tuple &other);
 
-  // assign operator, deep copy
+  // move constructor, takes over the data of other
+  Tuple(Tuple &&other) noexcept;
+
+  // assign operator, deep copy (shallow for a view)
   Tuple &operator=(const Tuple &other);
 
+  // move assign operator, takes over the data of other
+  Tuple &operator=(Tuple &&other) noexcept;
+
   ~Tuple() {
     if (allocated_) {
       delete[] data_;
@@ -74,6 +91,18 @@ class Tuple {
   // checks the schema to see how to return the Value.
   Value GetValue(const Schema *schema, uint32_t column_idx) const;
 
+  // Read a fixed-size column straight from the tuple bytes, without constructing a Value. T must be the C++ type of the
+  // column, e.g. int32_t for an INTEGER column; a NULL column reads as the NULL value of its type, e.g.
+  // BUSTUB_INT32_NULL.
+  template <typename T>
+  inline T GetAs(const Schema *schema, uint32_t column_idx) const {
+    const auto &accessor = schema->GetAccessor(column_idx);
+    assert(data_ != nullptr && accessor.is_inlined_ && accessor.size_ == sizeof(T));
+    T value;
+    memcpy(&value, data_ + accessor.offset_, sizeof(T));
+    return value;
+  }
+
   // Generates a key tuple given schemas and attributes
   Tuple KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs);
 
@@ -84,6 +113,9 @@ class Tuple {
   }
   inline bool IsAllocated() { return allocated_; }
 
+  // Get a copy of this tuple that owns its data, e.g. to keep a view past the lifetime of the data it points to
+  Tuple Materialize() const;
+
   std::string ToString(const Schema *schema) const;
 
  private:
@@ -0,0 +1,350 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// async_disk_io.cpp
+//
+// Identification: src/storage/disk/async_disk_io.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/disk/async_disk_io.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "common/exception.h"
+#include "common/logger.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define BUSTUB_HAS_IO_URING 1
+#else
+#define BUSTUB_HAS_IO_URING 0
+#endif
+
+namespace bustub {
+
+std::unique_ptr<AsyncDiskIO> AsyncDiskIO::Create(DiskManager *disk_manager, size_t queue_depth) {
+  BUSTUB_ASSERT(queue_depth > 0, "queue depth must be positive");
+  try {
+    return std::make_unique<IoUringDiskIO>(disk_manager, queue_depth);
+  } catch (Exception &e) {
+    LOG_DEBUG("io_uring is not available, falling back to a thread pool");
+  }
+  // Every thread blocks on one I/O; past a handful of them, more threads mostly add context switches.
+  return std::make_unique<ThreadPoolDiskIO>(disk_manager, std::min<size_t>(queue_depth, 8));
+}
+
+/*****************************************************************************
+ * THREAD POOL
+ *****************************************************************************/
+
+ThreadPoolDiskIO::ThreadPoolDiskIO(DiskManager *disk_manager, size_t num_threads) : disk_manager_(disk_manager) {
+  for (size_t i = 0; i < num_threads; i++) {
+    threads_.emplace_back([this] {
+      std::unique_lock lock(latch_);
+      while (true) {
+        cv_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+        // Pending requests are still served once the pool is stopping.
+        if (queue_.empty()) {
+          break;
+        }
+        Request request = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        if (request.is_write_) {
+          disk_manager_->WritePage(request.page_id_, request.page_data_);
+        } else {
+          disk_manager_->ReadPage(request.page_id_, request.page_data_);
+        }
+        request.promise_.set_value(true);
+        lock.lock();
+      }
+    });
+  }
+}
+
+ThreadPoolDiskIO::~ThreadPoolDiskIO() {
+  {
+    std::scoped_lock lock(latch_);
+    running_ = false;
+  }
+  cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+std::future<bool> ThreadPoolDiskIO::SubmitRead(page_id_t page_id, char *page_data) {
+  return Submit(false, page_id, page_data);
+}
+
+std::future<bool> ThreadPoolDiskIO::SubmitWrite(page_id_t page_id, const char *page_data) {
+  return Submit(true, page_id, const_cast<char *>(page_data));
+}
+
+std::future<bool> ThreadPoolDiskIO::Submit(bool is_write, page_id_t page_id, char *page_data) {
+  std::future<bool> future;
+  {
+    std::scoped_lock lock(latch_);
+    queue_.push_back({is_write, page_id, page_data, std::promise<bool>()});
+    future = queue_.back().promise_.get_future();
+  }
+  cv_.notify_one();
+  return future;
+}
+
+/*****************************************************************************
+ * IO_URING
+ *****************************************************************************/
+
+#if BUSTUB_HAS_IO_URING
+
+/** An I/O in flight. Its address is the user data of its submission, and nullptr asks the completion thread to stop. */
+struct IoUringDiskIO::Request {
+  bool is_write_;
+  page_id_t page_id_;
+  char *page_data_;
+  iovec iov_;
+  std::promise<bool> promise_;
+};
+
+/** The queues shared with the kernel. The head and tail indexes are read and written with atomic builtins. */
+struct IoUringDiskIO::Ring {
+  int fd_ = -1;
+  void *sq_ptr_ = MAP_FAILED;
+  size_t sq_size_ = 0;
+  void *cq_ptr_ = MAP_FAILED;
+  size_t cq_size_ = 0;
+  io_uring_sqe *sqes_ = static_cast<io_uring_sqe *>(MAP_FAILED);
+  size_t sqes_size_ = 0;
+  unsigned *sq_head_;
+  unsigned *sq_tail_;
+  unsigned *sq_mask_;
+  unsigned *sq_array_;
+  unsigned *cq_head_;
+  unsigned *cq_tail_;
+  unsigned *cq_mask_;
+  io_uring_cqe *cqes_;
+
+  ~Ring() {
+    if (sqes_ != MAP_FAILED) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) {
+      munmap(cq_ptr_, cq_size_);
+    }
+    if (sq_ptr_ != MAP_FAILED) {
+      munmap(sq_ptr_, sq_size_);
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+};
+
+IoUringDiskIO::IoUringDiskIO(DiskManager *disk_manager, size_t queue_depth)
+    : disk_manager_(disk_manager), ring_(std::make_unique<Ring>()), queue_depth_(queue_depth) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_->fd_ = static_cast<int>(syscall(__NR_io_uring_setup, queue_depth, &params));
+  if (ring_->fd_ < 0) {
+    throw Exception("io_uring_setup failed");
+  }
+
+  ring_->sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring_->cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  // Newer kernels map both queues with a single mmap.
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    ring_->sq_size_ = ring_->cq_size_ = std::max(ring_->sq_size_, ring_->cq_size_);
+  }
+  ring_->sq_ptr_ =
+      mmap(nullptr, ring_->sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_->fd_, IORING_OFF_SQ_RING);
+  if (ring_->sq_ptr_ == MAP_FAILED) {
+    throw Exception("io_uring submission queue mmap failed");
+  }
+  ring_->cq_ptr_ = single_mmap ? ring_->sq_ptr_
+                               : mmap(nullptr, ring_->cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                      ring_->fd_, IORING_OFF_CQ_RING);
+  if (ring_->cq_ptr_ == MAP_FAILED) {
+    throw Exception("io_uring completion queue mmap failed");
+  }
+  ring_->sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  ring_->sqes_ = static_cast<io_uring_sqe *>(mmap(nullptr, ring_->sqes_size_, PROT_READ | PROT_WRITE,
+                                                  MAP_SHARED | MAP_POPULATE, ring_->fd_, IORING_OFF_SQES));
+  if (ring_->sqes_ == MAP_FAILED) {
+    throw Exception("io_uring submission entries mmap failed");
+  }
+
+  auto *sq_ptr = static_cast<char *>(ring_->sq_ptr_);
+  ring_->sq_head_ = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.head);
+  ring_->sq_tail_ = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.tail);
+  ring_->sq_mask_ = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.ring_mask);
+  ring_->sq_array_ = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.array);
+  auto *cq_ptr = static_cast<char *>(ring_->cq_ptr_);
+  ring_->cq_head_ = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.head);
+  ring_->cq_tail_ = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.tail);
+  ring_->cq_mask_ = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.ring_mask);
+  ring_->cqes_ = reinterpret_cast<io_uring_cqe *>(cq_ptr + params.cq_off.cqes);
+
+  reaper_ = std::thread([this] { ReapCompletions(); });
+}
+
+IoUringDiskIO::~IoUringDiskIO() {
+  if (!reaper_.joinable()) {
+    return;
+  }
+  std::unique_lock lock(latch_);
+  cv_.wait(lock, [this] { return in_flight_ == 0; });
+  // The sentinel completes after everything submitted before it, so the completion thread stops last.
+  unsigned tail = *ring_->sq_tail_;
+  unsigned index = tail & *ring_->sq_mask_;
+  io_uring_sqe *sqe = &ring_->sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = IORING_OP_NOP;
+  sqe->user_data = 0;
+  ring_->sq_array_[index] = index;
+  __atomic_store_n(ring_->sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  while (syscall(__NR_io_uring_enter, ring_->fd_, 1, 0, 0, nullptr, 0) < 0 && errno == EINTR) {
+  }
+  lock.unlock();
+  reaper_.join();
+}
+
+std::future<bool> IoUringDiskIO::SubmitRead(page_id_t page_id, char *page_data) {
+  return Submit(false, page_id, page_data);
+}
+
+std::future<bool> IoUringDiskIO::SubmitWrite(page_id_t page_id, const char *page_data) {
+  return Submit(true, page_id, const_cast<char *>(page_data));
+}
+
+std::future<bool> IoUringDiskIO::Submit(bool is_write, page_id_t page_id, char *page_data) {
+  auto *request = new Request{is_write, page_id, page_data, {page_data, PAGE_SIZE}, std::promise<bool>()};
+  std::future<bool> future = request->promise_.get_future();
+  off_t offset;
+  int db_fd = disk_manager_->GetSegment(page_id, is_write, &offset);
+
+  int rc = -1;
+  // A read from a segment that was never written does not go to the kernel; the DiskManager fills it with zeros.
+  if (db_fd >= 0) {
+    std::unique_lock lock(latch_);
+    // Bounding the I/Os in flight by the queue depth keeps both queues from overflowing.
+    cv_.wait(lock, [this] { return in_flight_ < queue_depth_; });
+    unsigned tail = *ring_->sq_tail_;
+    unsigned index = tail & *ring_->sq_mask_;
+    io_uring_sqe *sqe = &ring_->sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = db_fd;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<uint64_t>(&request->iov_);
+    sqe->len = 1;
+    sqe->user_data = reinterpret_cast<uint64_t>(request);
+    ring_->sq_array_[index] = index;
+    __atomic_store_n(ring_->sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+    while ((rc = static_cast<int>(syscall(__NR_io_uring_enter, ring_->fd_, 1, 0, 0, nullptr, 0))) < 0 &&
+           (errno == EINTR || errno == EAGAIN)) {
+    }
+    if (rc >= 0) {
+      in_flight_++;
+      return future;
+    }
+    // The kernel did not take the entry; take it back and do the I/O in the caller.
+    __atomic_store_n(ring_->sq_tail_, tail, __ATOMIC_RELEASE);
+    LOG_DEBUG("io_uring_enter failed, doing the I/O synchronously");
+  }
+
+  if (is_write) {
+    disk_manager_->WritePage(page_id, page_data);
+  } else {
+    disk_manager_->ReadPage(page_id, page_data);
+  }
+  request->promise_.set_value(true);
+  delete request;
+  return future;
+}
+
+void IoUringDiskIO::ReapCompletions() {
+  bool stop = false;
+  while (!stop) {
+    if (syscall(__NR_io_uring_enter, ring_->fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR) {
+      LOG_DEBUG("io_uring_enter failed while waiting for completions");
+    }
+
+    size_t num_completed = 0;
+    unsigned head = *ring_->cq_head_;
+    unsigned tail = __atomic_load_n(ring_->cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+      io_uring_cqe *cqe = &ring_->cqes_[head & *ring_->cq_mask_];
+      auto *request = reinterpret_cast<Request *>(cqe->user_data);
+      int result = cqe->res;
+      if (request == nullptr) {
+        stop = true;
+        continue;
+      }
+      num_completed++;
+      if (result == PAGE_SIZE) {
+        if (request->is_write_) {
+          disk_manager_->num_writes_ += 1;
+        }
+        request->promise_.set_value(true);
+      } else if (result < 0) {
+        LOG_DEBUG("I/O error in io_uring completion: %s", strerror(-result));
+        request->promise_.set_value(false);
+      } else {
+        // A short transfer, typically a read past the end of the file; the DiskManager handles those.
+        if (request->is_write_) {
+          disk_manager_->WritePage(request->page_id_, request->page_data_);
+        } else {
+          disk_manager_->ReadPage(request->page_id_, request->page_data_);
+        }
+        request->promise_.set_value(true);
+      }
+      delete request;
+    }
+    __atomic_store_n(ring_->cq_head_, head, __ATOMIC_RELEASE);
+
+    if (num_completed > 0) {
+      {
+        std::scoped_lock lock(latch_);
+        in_flight_ -= num_completed;
+      }
+      cv_.notify_all();
+    }
+  }
+}
+
+#else
+
+struct IoUringDiskIO::Request {};
+struct IoUringDiskIO::Ring {};
+
+IoUringDiskIO::IoUringDiskIO(DiskManager *disk_manager, size_t queue_depth)
+    : disk_manager_(disk_manager), queue_depth_(queue_depth) {
+  throw Exception("io_uring is not supported on this platform");
+}
+
+IoUringDiskIO::~IoUringDiskIO() = default;
+
+std::future<bool> IoUringDiskIO::SubmitRead(page_id_t page_id, char *page_data) { return {}; }
+
+std::future<bool> IoUringDiskIO::SubmitWrite(page_id_t page_id, const char *page_data) { return {}; }
+
+std::future<bool> IoUringDiskIO::Submit(bool is_write, page_id_t page_id, char *page_data) { return {}; }
+
+void IoUringDiskIO::ReapCompletions() {}
+
+#endif
+
+}  // namespace bustub
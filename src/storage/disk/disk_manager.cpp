@@ -10,8 +10,12 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
 #include <cassert>
+#include <cerrno>
 #include <cstring>
 #include <iostream>
 #include <mutex>  // NOLINT
@@ -27,11 +31,17 @@ namespace bustub {
 static char *buffer_used;
 
 /**
- * Constructor: open/create a single database file & log file
+ * Constructor: open/create the first database segment & log file
  * @input db_file: database file name
+ * @input pages_per_segment: number of pages in each segment file, 0 for a single file
  */
-DiskManager::DiskManager(const std::string &db_file)
-    : file_name_(db_file), num_flushes_(0), num_writes_(0), flush_log_(false), flush_log_f_(nullptr) {
+DiskManager::DiskManager(const std::string &db_file, size_t pages_per_segment)
+    : file_name_(db_file),
+      pages_per_segment_(pages_per_segment),
+      num_flushes_(0),
+      num_writes_(0),
+      flush_log_(false),
+      flush_log_f_(nullptr) {
   std::string::size_type n = file_name_.rfind('.');
   if (n == std::string::npos) {
     LOG_DEBUG("wrong file format");
@@ -53,79 +63,130 @@ DiskManager::DiskManager(const std::string &db_file)
     }
   }
 
-  std::scoped_lock scoped_db_io_latch(db_io_latch_);
-  db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-  // directory or file does not exist
-  if (!db_io_.is_open()) {
-    db_io_.clear();
-    // create a new file
-    db_io_.open(db_file, std::ios::binary | std::ios::trunc | std::ios::out);
-    db_io_.close();
-    // reopen with original mode
-    db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-    if (!db_io_.is_open()) {
-      throw Exception("can't open db file");
-    }
+  // create the file if it does not exist
+  int db_fd = open(db_file.c_str(), O_RDWR | O_CREAT, 0644);
+  if (db_fd < 0) {
+    throw Exception("can't open db file");
   }
+  db_fds_.emplace_back(db_fd);
   buffer_used = nullptr;
 }
 
+DiskManager::~DiskManager() {
+  for (int db_fd : db_fds_) {
+    if (db_fd >= 0) {
+      close(db_fd);
+    }
+  }
+}
+
 /**
  * Close all file streams
  */
 void DiskManager::ShutDown() {
   {
-    std::scoped_lock scoped_db_io_latch(db_io_latch_);
-    db_io_.close();
+    std::unique_lock db_fds_lock(db_fds_latch_);
+    for (int &db_fd : db_fds_) {
+      if (db_fd >= 0) {
+        close(db_fd);
+      }
+      db_fd = -1;
+    }
+    shut_down_ = true;
   }
   log_io_.close();
 }
 
+/**
+ * Map a page to its segment file and offset, opening the segment on first use
+ */
+int DiskManager::GetSegment(page_id_t page_id, bool create, off_t *offset) {
+  auto page_no = static_cast<uint64_t>(page_id);
+  size_t segment = 0;
+  if (pages_per_segment_ != 0) {
+    segment = page_no / pages_per_segment_;
+    page_no %= pages_per_segment_;
+  }
+  *offset = static_cast<off_t>(page_no) * PAGE_SIZE;
+
+  {
+    std::shared_lock db_fds_lock(db_fds_latch_);
+    if (shut_down_) {
+      LOG_DEBUG("I/O after the disk manager was shut down");
+      return -1;
+    }
+    if (segment < db_fds_.size() && (db_fds_[segment] >= 0 || (db_fds_[segment] == MISSING_SEGMENT && !create))) {
+      return std::max(db_fds_[segment], -1);
+    }
+  }
+  std::unique_lock db_fds_lock(db_fds_latch_);
+  if (shut_down_) {
+    LOG_DEBUG("I/O after the disk manager was shut down");
+    return -1;
+  }
+  if (segment >= db_fds_.size()) {
+    db_fds_.resize(segment + 1, -1);
+  }
+  if (db_fds_[segment] < 0 && (db_fds_[segment] != MISSING_SEGMENT || create)) {
+    int db_fd = open(GetSegmentName(segment).c_str(), create ? O_RDWR | O_CREAT : O_RDWR, 0644);
+    // Remember a segment that does not exist, so that reads from it do not take the latch exclusively every time.
+    db_fds_[segment] = db_fd < 0 && errno == ENOENT ? MISSING_SEGMENT : db_fd;
+  }
+  return std::max(db_fds_[segment], -1);
+}
+
 /**
  * Write the contents of the specified page into disk file
  */
 void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
-  std::scoped_lock scoped_db_io_latch(db_io_latch_);
-  size_t offset = static_cast<size_t>(page_id) * PAGE_SIZE;
-  // set write cursor to offset
+  off_t offset;
+  int db_fd = GetSegment(page_id, true, &offset);
   num_writes_ += 1;
-  db_io_.seekp(offset);
-  db_io_.write(page_data, PAGE_SIZE);
-  // check for I/O error
-  if (db_io_.bad()) {
-    LOG_DEBUG("I/O error while writing");
+  if (db_fd < 0) {
+    LOG_DEBUG("I/O error while opening segment");
     return;
   }
-  // needs to flush to keep disk file in sync
-  db_io_.flush();
+  // pwrite does not move a shared cursor, so concurrent writes to different pages need no latch
+  size_t write_count = 0;
+  while (write_count < PAGE_SIZE) {
+    ssize_t rc = pwrite(db_fd, page_data + write_count, PAGE_SIZE - write_count, offset + write_count);
+    if (rc < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_DEBUG("I/O error while writing");
+      return;
+    }
+    write_count += rc;
+  }
 }
 
 /**
  * Read the contents of the specified page into the given memory area
  */
 void DiskManager::ReadPage(page_id_t page_id, char *page_data) {
-  std::scoped_lock scoped_db_io_latch(db_io_latch_);
-  int offset = page_id * PAGE_SIZE;
-  // check if read beyond file length
-  if (offset > GetFileSize(file_name_)) {
-    LOG_DEBUG("I/O error reading past end of file");
-    // std::cerr << "I/O error while reading" << std::endl;
-  } else {
-    // set read cursor to offset
-    db_io_.seekp(offset);
-    db_io_.read(page_data, PAGE_SIZE);
-    if (db_io_.bad()) {
+  off_t offset;
+  // a segment that was never written reads as zeros
+  int db_fd = GetSegment(page_id, false, &offset);
+  size_t read_count = 0;
+  while (db_fd >= 0 && read_count < PAGE_SIZE) {
+    ssize_t rc = pread(db_fd, page_data + read_count, PAGE_SIZE - read_count, offset + read_count);
+    if (rc < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
       LOG_DEBUG("I/O error while reading");
       return;
     }
-    // if file ends before reading PAGE_SIZE
-    int read_count = db_io_.gcount();
-    if (read_count < PAGE_SIZE) {
-      LOG_DEBUG("Read less than a page");
-      db_io_.clear();
-      // std::cerr << "Read less than a page" << std::endl;
-      memset(page_data + read_count, 0, PAGE_SIZE - read_count);
+    if (rc == 0) {
+      break;
     }
+    read_count += rc;
+  }
+  // if file ends before reading PAGE_SIZE, the rest of the page has never been written
+  if (read_count < PAGE_SIZE) {
+    LOG_DEBUG("Read less than a page");
+    memset(page_data + read_count, 0, PAGE_SIZE - read_count);
   }
 }
 
@@ -168,7 +229,7 @@ void DiskManager::WriteLog(char *log_data, int size) {
  * Always read from the beginning and perform sequence read
  * @return: false means already reach the end
  */
-bool DiskManager::ReadLog(char *log_data, int size, int offset) {
+bool DiskManager::ReadLog(char *log_data, int size, int64_t offset) {
   if (offset >= GetFileSize(log_name_)) {
     // LOG_DEBUG("end of log file");
     // LOG_DEBUG("file size is %d", GetFileSize(log_name_));
@@ -209,10 +270,10 @@ bool DiskManager::GetFlushState() const { return flush_log_; }
 /**
  * Private helper function to get disk file size
  */
-int DiskManager::GetFileSize(const std::string &file_name) {
+int64_t DiskManager::GetFileSize(const std::string &file_name) {
   struct stat stat_buf;
   int rc = stat(file_name.c_str(), &stat_buf);
-  return rc == 0 ? static_cast<int>(stat_buf.st_size) : -1;
+  return rc == 0 ? static_cast<int64_t>(stat_buf.st_size) : -1;
 }
 
 }  // namespace bustub
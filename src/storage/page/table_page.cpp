@@ -266,6 +266,16 @@ void TablePage::RollbackDelete(const RID &rid, Transaction *txn, LogManager *log
 }
 
 bool TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager) {
+  Tuple view;
+  if (!GetTupleView(rid, &view, txn, lock_manager)) {
+    return false;
+  }
+  // Copy the tuple data into our result.
+  *tuple = view.Materialize();
+  return true;
+}
+
+bool TablePage::GetTupleView(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager) {
   // Get the current slot number.
   uint32_t slot_num = rid.GetSlotNum();
   // If somehow we have more slots than tuples, abort the transaction.
@@ -292,16 +302,8 @@ bool TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockMan
     }
   }
 
-  // At this point, we have at least a shared lock on the RID. Copy the tuple data into our result.
-  uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
-  tuple->size_ = tuple_size;
-  if (tuple->allocated_) {
-    delete[] tuple->data_;
-  }
-  tuple->data_ = new char[tuple->size_];
-  memcpy(tuple->data_, GetData() + tuple_offset, tuple->size_);
-  tuple->rid_ = rid;
-  tuple->allocated_ = true;
+  // At this point, we have at least a shared lock on the RID. Point our result at the tuple data.
+  *tuple = Tuple(rid, GetData() + GetTupleOffsetAtSlot(slot_num), tuple_size);
   return true;
 }
 
@@ -0,0 +1,194 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map.cpp
+//
+// Identification: src/storage/table/free_space_map.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/free_space_map.h"
+
+#include "common/macros.h"
+
+namespace bustub {
+
+FreeSpaceMap::FreeSpaceMap(BufferPoolManager *buffer_pool_manager) : buffer_pool_manager_(buffer_pool_manager) {
+  page_id_t root_page_id;
+  auto root_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->NewPage(&root_page_id));
+  BUSTUB_ASSERT(root_page != nullptr, "Couldn't create a page for the free-space map.");
+  root_page->WLatch();
+  root_page->Init();
+  root_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(root_page_id, true);
+  fsm_page_ids_.emplace_back(root_page_id);
+}
+
+FreeSpaceMap::FreeSpaceMap(BufferPoolManager *buffer_pool_manager, page_id_t root_page_id)
+    : buffer_pool_manager_(buffer_pool_manager) {
+  // Load the whole map into memory.
+  page_id_t fsm_page_id = root_page_id;
+  while (fsm_page_id != INVALID_PAGE_ID) {
+    auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(fsm_page_id));
+    BUSTUB_ASSERT(fsm_page != nullptr, "Couldn't fetch a page of the free-space map.");
+    fsm_page->RLatch();
+    for (uint32_t i = 0; i < fsm_page->GetEntryCount(); i++) {
+      free_slots_[fsm_page->GetCategory(i)].insert(page_ids_.size());
+      slots_[fsm_page->GetPageId(i)] = page_ids_.size();
+      page_ids_.emplace_back(fsm_page->GetPageId(i));
+      categories_.emplace_back(fsm_page->GetCategory(i));
+    }
+    page_id_t next_page_id = fsm_page->GetNextPageId();
+    fsm_page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(fsm_page_id, false);
+    fsm_page_ids_.emplace_back(fsm_page_id);
+    fsm_page_id = next_page_id;
+  }
+}
+
+std::vector<page_id_t> FreeSpaceMap::GetPageIds() {
+  std::scoped_lock lock(latch_);
+  return page_ids_;
+}
+
+page_id_t FreeSpaceMap::GetLastPageId() {
+  std::scoped_lock lock(latch_);
+  return page_ids_.empty() ? INVALID_PAGE_ID : page_ids_.back();
+}
+
+bool FreeSpaceMap::AddPage(page_id_t page_id, uint32_t free_space, bool claim) {
+  // Only AddPage() changes the list of pages, so it is read here without latch_.
+  std::scoped_lock add_lock(add_latch_);
+  size_t slot = page_ids_.size();
+  size_t index = slot % FreeSpaceMapPage::CAPACITY;
+  page_id_t last_fsm_page_id = fsm_page_ids_.back();
+  bool new_fsm_page = slot / FreeSpaceMapPage::CAPACITY == fsm_page_ids_.size();
+  FreeSpaceMapPage *fsm_page;
+  page_id_t fsm_page_id;
+  if (new_fsm_page) {
+    // The last map page is full; chain a new one after it.
+    fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->NewPage(&fsm_page_id));
+    if (fsm_page == nullptr) {
+      return false;
+    }
+    auto prev_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(last_fsm_page_id));
+    if (prev_page == nullptr) {
+      buffer_pool_manager_->UnpinPage(fsm_page_id, false);
+      buffer_pool_manager_->DeletePage(fsm_page_id);
+      return false;
+    }
+    fsm_page->WLatch();
+    fsm_page->Init();
+    prev_page->WLatch();
+    prev_page->SetNextPageId(fsm_page_id);
+    prev_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(last_fsm_page_id, true);
+  } else {
+    fsm_page_id = last_fsm_page_id;
+    fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(fsm_page_id));
+    if (fsm_page == nullptr) {
+      return false;
+    }
+    fsm_page->WLatch();
+  }
+
+  uint8_t category = FreeSpaceMapPage::ToCategory(free_space);
+  fsm_page->SetPageId(index, page_id);
+  fsm_page->SetCategory(index, category);
+  fsm_page->SetEntryCount(index + 1);
+  fsm_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(fsm_page_id, true);
+
+  std::scoped_lock lock(latch_);
+  if (new_fsm_page) {
+    fsm_page_ids_.emplace_back(fsm_page_id);
+  }
+  slots_[page_id] = slot;
+  page_ids_.emplace_back(page_id);
+  categories_.emplace_back(category);
+  if (claim) {
+    claimed_.insert(page_id);
+  } else {
+    free_slots_[category].insert(slot);
+  }
+  return true;
+}
+
+page_id_t FreeSpaceMap::FindPage(uint32_t required_space) {
+  std::scoped_lock lock(latch_);
+  // Take the fullest page with room, which leaves the emptier pages for larger tuples.
+  for (size_t category = FreeSpaceMapPage::ToRequiredCategory(required_space); category < NUM_CATEGORIES;
+       category++) {
+    if (free_slots_[category].empty()) {
+      continue;
+    }
+    size_t slot = *free_slots_[category].begin();
+    free_slots_[category].erase(free_slots_[category].begin());
+    claimed_.insert(page_ids_[slot]);
+    return page_ids_[slot];
+  }
+  return INVALID_PAGE_ID;
+}
+
+void FreeSpaceMap::ReleasePage(page_id_t page_id) {
+  std::scoped_lock lock(latch_);
+  if (claimed_.erase(page_id) > 0) {
+    size_t slot = slots_[page_id];
+    free_slots_[categories_[slot]].insert(slot);
+  }
+}
+
+void FreeSpaceMap::UpdatePage(page_id_t page_id, uint32_t free_space) {
+  size_t slot;
+  {
+    std::scoped_lock lock(latch_);
+    auto iter = slots_.find(page_id);
+    if (iter == slots_.end()) {
+      return;
+    }
+    slot = iter->second;
+    if (!SetCategory(slot, FreeSpaceMapPage::ToCategory(free_space))) {
+      return;
+    }
+  }
+  WriteCategory(slot);
+}
+
+bool FreeSpaceMap::SetCategory(size_t slot, uint8_t category) {
+  if (categories_[slot] == category) {
+    return false;
+  }
+  if (claimed_.count(page_ids_[slot]) == 0) {
+    free_slots_[categories_[slot]].erase(slot);
+    free_slots_[category].insert(slot);
+  }
+  categories_[slot] = category;
+  return true;
+}
+
+void FreeSpaceMap::WriteCategory(size_t slot) {
+  page_id_t fsm_page_id;
+  {
+    std::scoped_lock lock(latch_);
+    fsm_page_id = fsm_page_ids_[slot / FreeSpaceMapPage::CAPACITY];
+  }
+  auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(fsm_page_id));
+  if (fsm_page == nullptr) {
+    // The map is only a hint: the category in memory serves searches, and the map page keeps an older one.
+    return;
+  }
+  fsm_page->WLatch();
+  {
+    // Read the category under the page latch, so that of concurrent writers of the slot, the last one writes the
+    // latest category.
+    std::scoped_lock lock(latch_);
+    fsm_page->SetCategory(slot % FreeSpaceMapPage::CAPACITY, categories_[slot]);
+  }
+  fsm_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(fsm_page_id, true);
+}
+
+}  // namespace bustub
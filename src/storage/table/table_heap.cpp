@@ -22,7 +22,38 @@ TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_m
     : buffer_pool_manager_(buffer_pool_manager),
       lock_manager_(lock_manager),
       log_manager_(log_manager),
-      first_page_id_(first_page_id) {}
+      first_page_id_(first_page_id) {
+  auto first_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
+  BUSTUB_ASSERT(first_page != nullptr, "Couldn't fetch the first page of the table heap.");
+  first_page->WLatch();
+  page_id_t fsm_page_id = first_page->GetFreeSpaceMapPageId();
+  if (fsm_page_id != INVALID_PAGE_ID) {
+    first_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(first_page_id_, false);
+    fsm_ = std::make_unique<FreeSpaceMap>(buffer_pool_manager_, fsm_page_id);
+    return;
+  }
+
+  // The table has no free-space map yet; build it from its pages.
+  fsm_ = std::make_unique<FreeSpaceMap>(buffer_pool_manager_);
+  first_page->SetFreeSpaceMapPageId(fsm_->GetRootPageId());
+  [[maybe_unused]] bool added = fsm_->AddPage(first_page_id_, first_page->GetFreeSpaceRemaining(), false);
+  BUSTUB_ASSERT(added, "Couldn't record a page in the free-space map.");
+  page_id_t page_id = first_page->GetNextPageId();
+  first_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(first_page_id_, true);
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    BUSTUB_ASSERT(page != nullptr, "Couldn't fetch a page of the table heap.");
+    page->RLatch();
+    added = fsm_->AddPage(page_id, page->GetFreeSpaceRemaining(), false);
+    BUSTUB_ASSERT(added, "Couldn't record a page in the free-space map.");
+    page_id_t next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
 
 TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
                      Transaction *txn)
@@ -32,6 +63,11 @@ TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_m
   BUSTUB_ASSERT(first_page != nullptr, "Couldn't create a page for the table heap.");
   first_page->WLatch();
   first_page->Init(first_page_id_, PAGE_SIZE, INVALID_LSN, log_manager_, txn);
+  // Create the free-space map and record it in the first page.
+  fsm_ = std::make_unique<FreeSpaceMap>(buffer_pool_manager_);
+  first_page->SetFreeSpaceMapPageId(fsm_->GetRootPageId());
+  [[maybe_unused]] bool added = fsm_->AddPage(first_page_id_, first_page->GetFreeSpaceRemaining(), false);
+  BUSTUB_ASSERT(added, "Couldn't record a page in the free-space map.");
   first_page->WUnlatch();
   buffer_pool_manager_->UnpinPage(first_page_id_, true);
 }
@@ -42,54 +78,76 @@ bool TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) {
     return false;
   }
 
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
-  if (cur_page == nullptr) {
-    txn->SetState(TransactionState::ABORTED);
-    return false;
-  }
-
-  cur_page->WLatch();
-  // Insert into the first page with enough space. If no such page exists, create a new page and insert into that.
-  // INVARIANT: cur_page is WLatched if you leave the loop normally.
-  while (!cur_page->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_)) {
-    auto next_page_id = cur_page->GetNextPageId();
-    // If the next page is a valid page,
-    if (next_page_id != INVALID_PAGE_ID) {
-      // Unlatch and unpin the current page.
-      cur_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
-      // And repeat the process with the next page.
-      cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
-      cur_page->WLatch();
-    } else {
-      // Otherwise we have run out of valid pages. We need to create a new page.
-      auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPage(&next_page_id));
-      // If we could not create a new page,
-      if (new_page == nullptr) {
-        // Then life sucks and we abort the transaction.
-        cur_page->WUnlatch();
-        buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
+  // Insert into a page the free-space map knows to have enough space. If there is no such page, create a new page and
+  // insert into that. The map hands concurrent inserters different pages, so they do not wait on each other's latches.
+  uint32_t required_space = TablePage::GetRequiredSpace(tuple);
+  while (true) {
+    page_id_t page_id = fsm_->FindPage(required_space);
+    if (page_id == INVALID_PAGE_ID) {
+      page_id = AppendPage(txn);
+      // If we could not create a new page, then life sucks and we abort the transaction.
+      if (page_id == INVALID_PAGE_ID) {
         txn->SetState(TransactionState::ABORTED);
         return false;
       }
-      // Otherwise we were able to create a new page. We initialize it now.
-      new_page->WLatch();
-      cur_page->SetNextPageId(next_page_id);
-      new_page->Init(next_page_id, PAGE_SIZE, cur_page->GetTablePageId(), log_manager_, txn);
-      cur_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
-      cur_page = new_page;
+    }
+
+    auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (cur_page == nullptr) {
+      fsm_->ReleasePage(page_id);
+      txn->SetState(TransactionState::ABORTED);
+      return false;
+    }
+    cur_page->WLatch();
+    bool inserted = cur_page->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_);
+    uint32_t free_space = cur_page->GetFreeSpaceRemaining();
+    cur_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, inserted);
+    fsm_->UpdatePage(page_id, free_space);
+    fsm_->ReleasePage(page_id);
+    // The map only underestimates free space, so a failed insert means the page changed since it was recorded; the
+    // map now has its actual free space and the search moves on.
+    if (inserted) {
+      break;
     }
   }
-  // This line has caused most of us to double-take and "whoa double unlatch".
-  // We are not, in fact, double unlatching. See the invariant above.
-  cur_page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
   // Update the transaction's write set.
   txn->GetWriteSet()->emplace_back(*rid, WType::INSERT, Tuple{}, this);
   return true;
 }
 
+page_id_t TableHeap::AppendPage(Transaction *txn) {
+  std::scoped_lock append_lock(append_latch_);
+  page_id_t last_page_id = fsm_->GetLastPageId();
+  auto last_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id));
+  if (last_page == nullptr) {
+    return INVALID_PAGE_ID;
+  }
+  page_id_t new_page_id;
+  auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPage(&new_page_id));
+  if (new_page == nullptr) {
+    buffer_pool_manager_->UnpinPage(last_page_id, false);
+    return INVALID_PAGE_ID;
+  }
+  // Initialize the new page and record it in the free-space map, and only then link it after the last page, so that a
+  // page the map could not record never becomes part of the table.
+  new_page->WLatch();
+  new_page->Init(new_page_id, PAGE_SIZE, last_page_id, log_manager_, txn);
+  uint32_t free_space = new_page->GetFreeSpaceRemaining();
+  new_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+  if (!fsm_->AddPage(new_page_id, free_space, true)) {
+    buffer_pool_manager_->UnpinPage(last_page_id, false);
+    buffer_pool_manager_->DeletePage(new_page_id);
+    return INVALID_PAGE_ID;
+  }
+  last_page->WLatch();
+  last_page->SetNextPageId(new_page_id);
+  last_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(last_page_id, true);
+  return new_page_id;
+}
+
 bool TableHeap::MarkDelete(const RID &rid, Transaction *txn) {
   // TODO(Amadou): remove empty page
   // Find the page which contains the tuple.
@@ -121,8 +179,12 @@ bool TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn
   Tuple old_tuple;
   page->WLatch();
   bool is_updated = page->UpdateTuple(tuple, &old_tuple, rid, txn, lock_manager_, log_manager_);
+  uint32_t free_space = page->GetFreeSpaceRemaining();
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), is_updated);
+  if (is_updated) {
+    fsm_->UpdatePage(rid.GetPageId(), free_space);
+  }
   // Update the transaction's write set.
   if (is_updated && txn->GetState() != TransactionState::ABORTED) {
     txn->GetWriteSet()->emplace_back(rid, WType::UPDATE, old_tuple, this);
@@ -138,8 +200,11 @@ void TableHeap::ApplyDelete(const RID &rid, Transaction *txn) {
   page->WLatch();
   page->ApplyDelete(rid, txn, log_manager_);
   lock_manager_->Unlock(txn, rid);
+  uint32_t free_space = page->GetFreeSpaceRemaining();
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  // The space of the tuple can be reused by inserts.
+  fsm_->UpdatePage(rid.GetPageId(), free_space);
 }
 
 void TableHeap::RollbackDelete(const RID &rid, Transaction *txn) {
@@ -169,24 +234,47 @@ bool TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn) {
   return res;
 }
 
-TableIterator TableHeap::Begin(Transaction *txn) {
-  // Start an iterator from the first page.
-  // TODO(Wuwen): Hacky fix for now. Removing empty pages is a better way to handle this.
-  RID rid;
-  auto page_id = first_page_id_;
-  while (page_id != INVALID_PAGE_ID) {
+bool TableHeap::GetTuples(const std::vector<RID> &rids, std::vector<Tuple> *tuples, Transaction *txn) {
+  size_t i = 0;
+  while (i < rids.size()) {
+    page_id_t page_id = rids[i].GetPageId();
     auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page == nullptr) {
+      txn->SetState(TransactionState::ABORTED);
+      return false;
+    }
+    // Read all the tuples of the page that come next while it is pinned.
     page->RLatch();
-    // If this fails because there is no tuple, then RID will be the default-constructed value, which means EOF.
-    auto found_tuple = page->GetFirstTupleRid(&rid);
+    for (; i < rids.size() && rids[i].GetPageId() == page_id; i++) {
+      Tuple tuple;
+      if (page->GetTuple(rids[i], &tuple, txn, lock_manager_)) {
+        tuples->emplace_back(std::move(tuple));
+      }
+    }
     page->RUnlatch();
     buffer_pool_manager_->UnpinPage(page_id, false);
-    if (found_tuple) {
-      break;
-    }
-    page_id = page->GetNextPageId();
   }
-  return TableIterator(this, rid, txn);
+  return true;
+}
+
+TableIterator TableHeap::Begin(Transaction *txn, BufferAccessStrategy *strategy) {
+  // Start an iterator from the first page; it skips ahead over pages that have no tuples.
+  return TableIterator(this, RID(first_page_id_, 0), txn, strategy);
+}
+
+std::vector<TableHeap::Morsel> TableHeap::GetMorsels(size_t pages_per_morsel) {
+  // The free-space map lists the pages in table order, so there is no need to walk the page chain.
+  std::vector<page_id_t> page_ids = fsm_->GetPageIds();
+  std::vector<Morsel> morsels;
+  for (size_t i = 0; i < page_ids.size(); i += pages_per_morsel) {
+    size_t end = i + pages_per_morsel;
+    morsels.push_back({page_ids[i], end < page_ids.size() ? page_ids[end] : INVALID_PAGE_ID});
+  }
+  return morsels;
+}
+
+TableIterator TableHeap::Begin(const Morsel &morsel, Transaction *txn, BufferAccessStrategy *strategy) {
+  return TableIterator(this, RID(morsel.first_page_id_, 0), txn, strategy, morsel.end_page_id_);
 }
 
 TableIterator TableHeap::End() { return TableIterator(this, RID(INVALID_PAGE_ID, 0), nullptr); }
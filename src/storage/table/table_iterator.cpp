@@ -11,57 +11,81 @@
 //===----------------------------------------------------------------------===//
 
 #include <cassert>
+#include <cstring>
 
 #include "storage/table/table_heap.h"
 
 namespace bustub {
 
-TableIterator::TableIterator(TableHeap *table_heap, RID rid, Transaction *txn)
-    : table_heap_(table_heap), tuple_(new Tuple(rid)), txn_(txn) {
+TableIterator::TableIterator(TableHeap *table_heap, RID rid, Transaction *txn, BufferAccessStrategy *strategy,
+                             page_id_t end_page_id)
+    : table_heap_(table_heap), txn_(txn), strategy_(strategy), end_page_id_(end_page_id) {
   if (rid.GetPageId() != INVALID_PAGE_ID) {
-    table_heap_->GetTuple(tuple_->rid_, tuple_, txn_);
+    LoadPage(rid.GetPageId(), rid.GetSlotNum());
   }
 }
 
 const Tuple &TableIterator::operator*() {
-  assert(*this != table_heap_->End());
-  return *tuple_;
+  assert(cursor_ < tuples_.size());
+  return tuples_[cursor_];
 }
 
 Tuple *TableIterator::operator->() {
-  assert(*this != table_heap_->End());
-  return tuple_;
+  assert(cursor_ < tuples_.size());
+  return &tuples_[cursor_];
 }
 
 TableIterator &TableIterator::operator++() {
-  BufferPoolManager *buffer_pool_manager = table_heap_->buffer_pool_manager_;
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(tuple_->rid_.GetPageId()));
-  cur_page->RLatch();
-  assert(cur_page != nullptr);  // all pages are pinned
+  assert(cursor_ < tuples_.size());
+  if (++cursor_ == tuples_.size()) {
+    LoadPage(next_page_id_, 0);
+  }
+  return *this;
+}
 
-  RID next_tuple_rid;
-  if (!cur_page->GetNextTupleRid(tuple_->rid_,
-                                 &next_tuple_rid)) {  // end of this page
-    while (cur_page->GetNextPageId() != INVALID_PAGE_ID) {
-      auto next_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(cur_page->GetNextPageId()));
-      cur_page->RUnlatch();
-      buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
-      cur_page = next_page;
-      cur_page->RLatch();
-      if (cur_page->GetFirstTupleRid(&next_tuple_rid)) {
-        break;
+void TableIterator::LoadPage(page_id_t page_id, uint32_t start_slot) {
+  BufferPoolManager *buffer_pool_manager = table_heap_->buffer_pool_manager_;
+  tuples_.clear();
+  cursor_ = 0;
+  while (page_id != INVALID_PAGE_ID && page_id != end_page_id_) {
+    auto page = static_cast<TablePage *>(buffer_pool_manager->FetchPageWithStrategy(page_id, strategy_));
+    assert(page != nullptr);  // all pages are pinned
+    page->RLatch();
+    next_page_id_ = page->GetNextPageId();
+    // Read the page after this one while the scan works through this one.
+    if (next_page_id_ != end_page_id_) {
+      buffer_pool_manager->Prefetch(next_page_id_, strategy_);
+    }
+    RID rid;
+    for (bool found = page->GetFirstTupleRid(&rid); found; found = page->GetNextTupleRid(rid, &rid)) {
+      if (rid.GetSlotNum() < start_slot) {
+        continue;
+      }
+      tuples_.emplace_back();
+      if (!page->GetTupleView(rid, &tuples_.back(), txn_, table_heap_->lock_manager_)) {
+        tuples_.pop_back();
       }
     }
+    if (!tuples_.empty()) {
+      // Copy the page and repoint the views at the copy, so that they stay valid once the page is released.
+      if (page_data_ == nullptr || page_data_.use_count() > 1) {
+        page_data_.reset(new char[PAGE_SIZE]);
+      }
+      memcpy(page_data_.get(), page->GetData(), PAGE_SIZE);
+      for (auto &tuple : tuples_) {
+        tuple.data_ = page_data_.get() + (tuple.data_ - page->GetData());
+      }
+    }
+    page->RUnlatch();
+    buffer_pool_manager->UnpinPage(page_id, false);
+    if (!tuples_.empty()) {
+      return;
+    }
+    // Skip pages that have no tuples left.
+    page_id = next_page_id_;
+    start_slot = 0;
   }
-  tuple_->rid_ = next_tuple_rid;
-
-  if (*this != table_heap_->End()) {
-    table_heap_->GetTuple(tuple_->rid_, tuple_, txn_);
-  }
-  // release until copy the tuple
-  cur_page->RUnlatch();
-  buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
-  return *this;
+  next_page_id_ = INVALID_PAGE_ID;
 }
 
 TableIterator TableIterator::operator++(int) {
@@ -67,6 +67,13 @@ Tuple::Tuple(const Tuple &other) : allocated_(other.allocated_), rid_(other.rid_
   }
 }
 
+Tuple::Tuple(Tuple &&other) noexcept
+    : allocated_(other.allocated_), rid_(other.rid_), size_(other.size_), data_(other.data_) {
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+}
+
 Tuple &Tuple::operator=(const Tuple &other) {
   if (allocated_) {
     delete[] data_;
@@ -87,10 +94,36 @@ Tuple &Tuple::operator=(const Tuple &other) {
   return *this;
 }
 
+Tuple &Tuple::operator=(Tuple &&other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (allocated_) {
+    delete[] data_;
+  }
+  allocated_ = other.allocated_;
+  rid_ = other.rid_;
+  size_ = other.size_;
+  data_ = other.data_;
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+  return *this;
+}
+
+Tuple Tuple::Materialize() const {
+  Tuple tuple(rid_);
+  tuple.size_ = size_;
+  tuple.data_ = new char[size_];
+  memcpy(tuple.data_, data_, size_);
+  tuple.allocated_ = true;
+  return tuple;
+}
+
 Value Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const {
   assert(schema);
   assert(data_);
-  const TypeId column_type = schema->GetColumn(column_idx).GetType();
+  const TypeId column_type = schema->GetAccessor(column_idx).type_;
   const char *data_ptr = GetDataPtr(schema, column_idx);
   // the third parameter "is_inlined" is unused
   return Value::DeserializeFrom(data_ptr, column_type);
@@ -108,14 +141,13 @@ Tuple Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const
 const char *Tuple::GetDataPtr(const Schema *schema, const uint32_t column_idx) const {
   assert(schema);
   assert(data_);
-  const auto &col = schema->GetColumn(column_idx);
-  bool is_inlined = col.IsInlined();
+  const auto &accessor = schema->GetAccessor(column_idx);
   // For inline type, data is stored where it is.
-  if (is_inlined) {
-    return (data_ + col.GetOffset());
+  if (accessor.is_inlined_) {
+    return (data_ + accessor.offset_);
   }
   // We read the relative offset from the tuple data.
-  int32_t offset = *reinterpret_cast<int32_t *>(data_ + col.GetOffset());
+  int32_t offset = *reinterpret_cast<int32_t *>(data_ + accessor.offset_);
   // And return the beginning address of the real data for the VARCHAR type.
   return (data_ + offset);
 }
@@ -11,9 +11,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "buffer/buffer_pool_manager_instance.h"
+#include <chrono>  // NOLINT
 #include <cstdio>
 #include <random>
 #include <string>
+#include <thread>  // NOLINT
+#include <vector>
 #include "buffer/buffer_pool_manager.h"
 #include "gtest/gtest.h"
 
@@ -141,4 +144,279 @@ TEST(BufferPoolManagerInstanceTest, SampleTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+// Hits and unpins on cached pages race with evictions driven by other threads
+TEST(BufferPoolManagerInstanceTest, ConcurrentHitTest) {
+  const std::string db_name = "test.db";
+  const size_t buffer_pool_size = 16;
+  const int num_hot_pages = 4;
+  const int num_threads = 4;
+  const int rounds = 2000;
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  page_id_t page_id_temp;
+  for (int i = 0; i < num_hot_pages; ++i) {
+    auto *page = bpm->NewPage(&page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "hot %d", page_id_temp);
+    EXPECT_EQ(true, bpm->UnpinPage(page_id_temp, true));
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([bpm, t] {
+      for (int r = 0; r < rounds; ++r) {
+        page_id_t page_id = (t + r) % num_hot_pages;
+        auto *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        char expected[PAGE_SIZE];
+        snprintf(expected, PAGE_SIZE, "hot %d", page_id);
+        EXPECT_EQ(0, strcmp(page->GetData(), expected));
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+      }
+    });
+  }
+  // Keep cycling new pages through the pool so that the hot pages keep being considered for eviction.
+  threads.emplace_back([bpm] {
+    page_id_t cold_page_id;
+    for (int r = 0; r < rounds; ++r) {
+      if (bpm->NewPage(&cold_page_id) != nullptr) {
+        EXPECT_EQ(true, bpm->UnpinPage(cold_page_id, r % 2 == 0));
+      }
+    }
+  });
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // Every pin was released, so the whole pool can be reused.
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    EXPECT_NE(nullptr, bpm->NewPage(&page_id_temp));
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+// Misses, dirty write backs and hits on the same pages race with each other; no update may be lost
+TEST(BufferPoolManagerInstanceTest, ConcurrentMissTest) {
+  const std::string db_name = "test.db";
+  const size_t buffer_pool_size = 8;
+  const int num_pages = 32;
+  const int num_threads = 4;
+  const int rounds = 1000;
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  page_id_t page_id_temp;
+  for (int i = 0; i < num_pages; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id_temp));
+    EXPECT_EQ(true, bpm->UnpinPage(page_id_temp, true));
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([bpm, t] {
+      for (int r = 0; r < rounds; ++r) {
+        page_id_t page_id = (r * 7 + t) % num_pages;
+        Page *page = nullptr;
+        // All frames may be pinned by the other threads for a moment.
+        while ((page = bpm->FetchPage(page_id)) == nullptr) {
+          std::this_thread::yield();
+        }
+        ASSERT_EQ(page_id, page->GetPageId());
+        page->WLatch();
+        ++*reinterpret_cast<int *>(page->GetData());
+        page->WUnlatch();
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  int total = 0;
+  for (int i = 0; i < num_pages; ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    total += *reinterpret_cast<int *>(page->GetData());
+    EXPECT_EQ(true, bpm->UnpinPage(i, false));
+  }
+  EXPECT_EQ(num_threads * rounds, total);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+// The page cleaner writes back cold dirty pages so that evictions do not have to
+TEST(BufferPoolManagerInstanceTest, PageCleanerTest) {
+  const std::string db_name = "test.db";
+  const size_t buffer_pool_size = 10;
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    auto *page = bpm->NewPage(&page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %d", page_id_temp);
+    EXPECT_EQ(true, bpm->UnpinPage(page_id_temp, true));
+  }
+
+  bpm->RunPageCleaner(buffer_pool_size);
+  for (int i = 0; i < 500 && bpm->GetNumPagesCleaned() < buffer_pool_size; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(buffer_pool_size, bpm->GetNumPagesCleaned());
+
+  // Scenario: every victim is clean now, so replacing the whole pool needs no foreground write back.
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id_temp));
+    EXPECT_EQ(true, bpm->UnpinPage(page_id_temp, false));
+  }
+  EXPECT_EQ(0, bpm->GetNumForegroundWriteBacks());
+  bpm->StopPageCleaner();
+
+  // Scenario: the cleaned pages made it to disk.
+  for (int i = 0; i < static_cast<int>(buffer_pool_size); ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    char expected[PAGE_SIZE];
+    snprintf(expected, PAGE_SIZE, "page %d", i);
+    EXPECT_EQ(0, strcmp(page->GetData(), expected));
+    EXPECT_EQ(true, bpm->UnpinPage(i, false));
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+// A scan reading through an access strategy recycles its ring instead of evicting other pages
+TEST(BufferPoolManagerInstanceTest, AccessStrategyTest) {
+  const std::string db_name = "test.db";
+  const size_t buffer_pool_size = 32;
+  const int num_hot_pages = 8;
+  const int num_scan_pages = 64;
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  page_id_t page_id_temp;
+  for (int i = 0; i < num_hot_pages + num_scan_pages; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id_temp));
+    EXPECT_EQ(true, bpm->UnpinPage(page_id_temp, true));
+  }
+  bpm->FlushAllPages();
+  // The hot pages are brought back in and dirtied, so evicting one of them would show up as a disk write.
+  for (int i = 0; i < num_hot_pages; ++i) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+    EXPECT_EQ(true, bpm->UnpinPage(i, true));
+  }
+  int num_writes = disk_manager->GetNumWrites();
+
+  {
+    BufferAccessStrategy strategy(4);
+    // Scenario: the scan holds on to the current page while it fetches the next one, like TableIterator does.
+    Page *prev_page = nullptr;
+    for (int i = num_hot_pages; i < num_hot_pages + num_scan_pages; ++i) {
+      auto *page = bpm->FetchPageWithStrategy(i, &strategy);
+      ASSERT_NE(nullptr, page);
+      EXPECT_EQ(i, page->GetPageId());
+      if (prev_page != nullptr) {
+        EXPECT_EQ(true, bpm->UnpinPage(prev_page->GetPageId(), false));
+      }
+      prev_page = page;
+    }
+    EXPECT_EQ(true, bpm->UnpinPage(prev_page->GetPageId(), false));
+  }
+  EXPECT_EQ(num_writes, disk_manager->GetNumWrites());
+
+  // Scenario: once the strategy is gone, its frames are regular frames again and the whole pool can be reused.
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    EXPECT_NE(nullptr, bpm->NewPage(&page_id_temp));
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+// Pages read ahead in the background are cached, unpinned, by the time they are fetched
+TEST(BufferPoolManagerInstanceTest, PrefetchTest) {
+  const std::string db_name = "test.db";
+  const size_t buffer_pool_size = 10;
+  const size_t num_prefetched = 5;
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  // The first pages end up evicted by the ones created after them.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < 2 * buffer_pool_size; ++i) {
+    auto *page = bpm->NewPage(&page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %d", page_id_temp);
+    EXPECT_EQ(true, bpm->UnpinPage(page_id_temp, true));
+  }
+
+  bpm->PrefetchRange(0, num_prefetched);
+  for (int i = 0; i < 500 && bpm->GetNumPagesPrefetched() < num_prefetched; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(num_prefetched, bpm->GetNumPagesPrefetched());
+
+  // Scenario: pages that are cached or were never allocated are not read ahead.
+  bpm->Prefetch(2 * buffer_pool_size - 1);
+  bpm->Prefetch(2 * buffer_pool_size);
+  bpm->Prefetch(0);
+
+  // Scenario: the prefetched pages are unpinned, so the whole pool is still available.
+  std::vector<page_id_t> new_page_ids;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id_temp));
+    new_page_ids.emplace_back(page_id_temp);
+  }
+  for (page_id_t page_id : new_page_ids) {
+    EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+  }
+  EXPECT_EQ(num_prefetched, bpm->GetNumPagesPrefetched());
+
+  // Scenario: read-ahead into the pool that was just replaced, then fetch the pages it brought in.
+  bpm->PrefetchRange(0, num_prefetched);
+  for (int i = 0; i < static_cast<int>(num_prefetched); ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    char expected[PAGE_SIZE];
+    snprintf(expected, PAGE_SIZE, "page %d", i);
+    EXPECT_EQ(0, strcmp(page->GetData(), expected));
+    EXPECT_EQ(true, bpm->UnpinPage(i, false));
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+
+  delete bpm;
+  delete disk_manager;
+}
+
 }  // namespace bustub
@@ -0,0 +1,215 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// lru_k_replacer_test.cpp
+//
+// Identification: test/buffer/lru_k_replacer_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/clock_replacer.h"
+#include "buffer/lru_k_replacer.h"
+#include "buffer/lru_replacer.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(LRUKReplacerTest, SampleTest) {
+  LRUKReplacer lru_k_replacer(7, 2);
+
+  // Scenario: reference frames 1-4 once, and frames 1 and 2 a second time.
+  for (frame_id_t frame_id : {1, 2, 3, 4, 1, 2}) {
+    lru_k_replacer.Pin(frame_id);
+  }
+  for (frame_id_t frame_id : {1, 2, 3, 4}) {
+    lru_k_replacer.Unpin(frame_id);
+  }
+  EXPECT_EQ(4, lru_k_replacer.Size());
+
+  // Scenario: frames with fewer than K references go first, least recently used first, then the frames whose K-th
+  // most recent reference is the oldest.
+  int value;
+  EXPECT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(3, value);
+  EXPECT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(4, value);
+  EXPECT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+
+  // Scenario: a victimized frame starts over with an empty history.
+  lru_k_replacer.Pin(1);
+  lru_k_replacer.Unpin(1);
+  EXPECT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+  EXPECT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+  EXPECT_FALSE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(0, lru_k_replacer.Size());
+}
+
+TEST(LRUKReplacerTest, CorrelatedReferenceTest) {
+  LRUKReplacer lru_k_replacer(7, 2, 3);
+
+  // Scenario: frame 1 is referenced three times in a burst, which counts as a single reference. Frame 2 is referenced
+  // twice, far enough apart.
+  for (frame_id_t frame_id : {2, 1, 1, 1, 3, 4, 5, 2, 6, 0, 6, 0}) {
+    lru_k_replacer.Pin(frame_id);
+  }
+  lru_k_replacer.Unpin(1);
+  lru_k_replacer.Unpin(2);
+
+  int value;
+  EXPECT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+
+  // Scenario: a frame still inside its correlated reference period is only evicted if there is no other choice.
+  lru_k_replacer.Unpin(0);
+  EXPECT_EQ(std::vector<frame_id_t>({2, 0}), lru_k_replacer.PeekVictims(7));
+  EXPECT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+  EXPECT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(0, value);
+
+  // Scenario: a reference exactly one period after the previous one is a new reference, and a frame last referenced
+  // exactly one period ago is outside its period. Frame 0 thus has two references and is evicted after frame 1.
+  LRUKReplacer boundary_replacer(4, 2, 2);
+  for (frame_id_t frame_id : {0, 2, 0, 1, 2, 3}) {
+    boundary_replacer.Pin(frame_id);
+  }
+  boundary_replacer.Unpin(0);
+  boundary_replacer.Unpin(1);
+  EXPECT_EQ(std::vector<frame_id_t>({1, 0}), boundary_replacer.PeekVictims(4));
+}
+
+namespace {
+
+/**
+ * Replays a page reference string against a replacer managing num_frames frames, the way a buffer pool would, and
+ * returns the hit rate.
+ */
+double ReplayReferences(Replacer *replacer, size_t num_frames, const std::vector<page_id_t> &references) {
+  std::unordered_map<page_id_t, frame_id_t> page_table;
+  std::vector<page_id_t> frame_pages(num_frames, INVALID_PAGE_ID);
+  size_t next_free_frame = 0;
+  size_t hits = 0;
+  for (page_id_t page_id : references) {
+    frame_id_t frame_id;
+    if (auto iter = page_table.find(page_id); iter != page_table.end()) {
+      frame_id = iter->second;
+      hits++;
+    } else {
+      if (next_free_frame < num_frames) {
+        frame_id = static_cast<frame_id_t>(next_free_frame++);
+      } else {
+        EXPECT_TRUE(replacer->Victim(&frame_id));
+        page_table.erase(frame_pages[frame_id]);
+      }
+      page_table[page_id] = frame_id;
+      frame_pages[frame_id] = page_id;
+    }
+    replacer->Pin(frame_id);
+    replacer->Unpin(frame_id);
+  }
+  return static_cast<double>(hits) / static_cast<double>(references.size());
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+// LRU-K keeps a higher hit rate than LRU and Clock on zipfian point accesses to an index mixed with large scans
+TEST(LRUKReplacerTest, HitRateTest) {
+  const size_t num_frames = 64;
+  const int num_hot_pages = 256;
+  const int scan_length = 512;
+  const int num_references = 25000;
+  const double zipf_skew = 1.0;
+
+  std::vector<double> cdf(num_hot_pages);
+  double sum = 0;
+  for (int i = 0; i < num_hot_pages; ++i) {
+    sum += 1.0 / std::pow(i + 1, zipf_skew);
+    cdf[i] = sum;
+  }
+  std::mt19937 rng(15445);
+  std::uniform_real_distribution<double> uniform(0, sum);
+
+  // Every 2000 point accesses, a scan reads scan_length pages that are never touched again.
+  std::vector<page_id_t> references;
+  page_id_t next_scan_page = num_hot_pages;
+  while (references.size() < num_references) {
+    for (int i = 0; i < 2000; ++i) {
+      references.emplace_back(std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin());
+    }
+    for (int i = 0; i < scan_length; ++i) {
+      references.emplace_back(next_scan_page++);
+    }
+  }
+
+  LRUReplacer lru_replacer(num_frames);
+  ClockReplacer clock_replacer(num_frames);
+  LRUKReplacer lru_2_replacer(num_frames, 2);
+  LRUKReplacer lru_2_correlated_replacer(num_frames, 2, 4);
+  double lru_hit_rate = ReplayReferences(&lru_replacer, num_frames, references);
+  double clock_hit_rate = ReplayReferences(&clock_replacer, num_frames, references);
+  double lru_2_hit_rate = ReplayReferences(&lru_2_replacer, num_frames, references);
+  double lru_2_correlated_hit_rate = ReplayReferences(&lru_2_correlated_replacer, num_frames, references);
+  EXPECT_GT(lru_2_hit_rate, lru_hit_rate);
+  EXPECT_GT(lru_2_hit_rate, clock_hit_rate);
+  EXPECT_GT(lru_2_correlated_hit_rate, lru_hit_rate);
+}
+
+// NOLINTNEXTLINE
+// A buffer pool using LRU-K keeps its frequently used pages through a scan
+TEST(LRUKReplacerTest, BufferPoolManagerTest) {
+  const std::string db_name = "test.db";
+  const size_t buffer_pool_size = 10;
+
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm =
+      new BufferPoolManagerInstance(buffer_pool_size, disk_manager, nullptr, new LRUKReplacer(buffer_pool_size, 2));
+
+  page_id_t page_id_temp;
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id_temp));
+    EXPECT_EQ(true, bpm->UnpinPage(page_id_temp, true));
+  }
+  bpm->FlushAllPages();
+
+  // Pages 0-4 are referenced twice and left dirty.
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < 5; ++i) {
+      ASSERT_NE(nullptr, bpm->FetchPage(i));
+      EXPECT_EQ(true, bpm->UnpinPage(i, true));
+    }
+  }
+
+  // Scenario: a scan over pages 5-19 only replaces frames of pages referenced once, so none of the dirty pages is
+  // written back.
+  int num_writes = disk_manager->GetNumWrites();
+  for (int i = 5; i < 20; ++i) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+    EXPECT_EQ(true, bpm->UnpinPage(i, false));
+  }
+  EXPECT_EQ(num_writes, disk_manager->GetNumWrites());
+
+  disk_manager->ShutDown();
+  remove(db_name.c_str());
+  remove("test.log");
+
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
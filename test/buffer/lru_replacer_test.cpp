@@ -59,4 +59,22 @@ TEST(LRUReplacerTest, SampleTest) {
   EXPECT_EQ(4, value);
 }
 
+TEST(LRUReplacerTest, PeekVictimsTest) {
+  LRUReplacer lru_replacer(7);
+
+  lru_replacer.Unpin(3);
+  lru_replacer.Unpin(1);
+  lru_replacer.Unpin(2);
+  lru_replacer.Pin(1);
+
+  // Scenario: peeking returns the coldest frames first and does not remove them.
+  EXPECT_EQ(std::vector<frame_id_t>({3, 2}), lru_replacer.PeekVictims(5));
+  EXPECT_EQ(std::vector<frame_id_t>({3}), lru_replacer.PeekVictims(1));
+  EXPECT_EQ(2, lru_replacer.Size());
+
+  int value;
+  lru_replacer.Victim(&value);
+  EXPECT_EQ(3, value);
+}
+
 }  // namespace bustub
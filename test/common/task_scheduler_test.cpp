@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// task_scheduler_test.cpp
+//
+// Identification: test/common/task_scheduler_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/task_scheduler.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(TaskSchedulerTest, RunTest) {
+  TaskScheduler scheduler(3);
+  EXPECT_EQ(3, scheduler.GetNumWorkers());
+
+  // Scenario: every task runs exactly once, in a slot within bounds.
+  const size_t num_tasks = 1000;
+  const size_t num_slots = 4;
+  std::vector<std::atomic<int>> runs(num_tasks);
+  std::vector<std::atomic<int>> slot_runs(num_slots);
+  scheduler.Run(num_tasks, num_slots, [&](size_t task, size_t slot) {
+    ASSERT_LT(task, num_tasks);
+    ASSERT_LT(slot, num_slots);
+    runs[task]++;
+    slot_runs[slot]++;
+  });
+  int total = 0;
+  for (size_t i = 0; i < num_tasks; i++) {
+    EXPECT_EQ(1, runs[i]);
+  }
+  for (size_t i = 0; i < num_slots; i++) {
+    total += slot_runs[i];
+  }
+  EXPECT_EQ(num_tasks, total);
+
+  // Scenario: a job without tasks returns right away.
+  scheduler.Run(0, num_slots, [&](size_t task, size_t slot) { FAIL(); });
+}
+
+// NOLINTNEXTLINE
+TEST(TaskSchedulerTest, StealTest) {
+  TaskScheduler scheduler(3);
+
+  // Scenario: slot 0 is stuck on its first task, so the other slots must steal the rest of its range.
+  const size_t num_tasks = 40;
+  std::atomic<size_t> num_done{0};
+  std::vector<std::atomic<int>> runs(num_tasks);
+  scheduler.Run(num_tasks, 4, [&](size_t task, size_t slot) {
+    if (task == 0) {
+      while (num_done < num_tasks - 1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    runs[task]++;
+    num_done++;
+  });
+  EXPECT_EQ(num_tasks, num_done);
+  for (size_t i = 0; i < num_tasks; i++) {
+    EXPECT_EQ(1, runs[i]);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TaskSchedulerTest, ExceptionTest) {
+  TaskScheduler scheduler(3);
+
+  // Scenario: an exception thrown by a task reaches the caller, and the scheduler keeps working afterwards.
+  EXPECT_THROW(scheduler.Run(100, 4,
+                             [&](size_t task, size_t slot) {
+                               if (task == 42) {
+                                 throw std::runtime_error("task failed");
+                               }
+                             }),
+               std::runtime_error);
+
+  std::atomic<int> num_runs{0};
+  scheduler.Run(100, 4, [&](size_t task, size_t slot) { num_runs++; });
+  EXPECT_EQ(100, num_runs);
+}
+
+// NOLINTNEXTLINE
+TEST(TaskSchedulerTest, NestedRunTest) {
+  TaskScheduler scheduler(2);
+
+  // Scenario: tasks start jobs of their own, which finish even when every worker is busy.
+  std::atomic<int> num_runs{0};
+  scheduler.Run(8, 3, [&](size_t task, size_t slot) {
+    scheduler.Run(8, 3, [&](size_t inner_task, size_t inner_slot) { num_runs++; });
+  });
+  EXPECT_EQ(64, num_runs);
+}
+
+}  // namespace bustub
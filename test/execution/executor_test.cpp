@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -21,6 +24,7 @@
 #include "concurrency/transaction_manager.h"
 #include "execution/execution_engine.h"
 #include "execution/executor_context.h"
+#include "execution/executor_factory.h"
 #include "execution/executors/aggregation_executor.h"
 #include "execution/executors/insert_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
@@ -28,11 +32,17 @@
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/comparison_expression.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "execution/index_bounds.h"
 #include "execution/plans/delete_plan.h"
 #include "execution/plans/distinct_plan.h"
 #include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_scan_plan.h"
 #include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/nested_index_join_plan.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/topn_plan.h"
 #include "execution/plans/update_plan.h"
 #include "executor_test_util.h"  // NOLINT
 #include "gtest/gtest.h"
@@ -653,4 +663,536 @@ TEST_F(ExecutorTest, SimpleDistinctTest) {
   ASSERT_TRUE(std::equal(results.cbegin(), results.cend(), expected.cbegin()));
 }
 
+// SELECT col1, col2 FROM test_2 WHERE col2 < 5, pulled a batch at a time
+TEST_F(ExecutorTest, BatchSeqScanTest) {
+  TableInfo *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_2");
+  const Schema &schema = table_info->schema_;
+  auto *col1 = MakeColumnValueExpression(schema, 0, "col1");
+  auto *col2 = MakeColumnValueExpression(schema, 0, "col2");
+  auto *out_schema = MakeOutputSchema({{"col1", col1}, {"col2", col2}});
+
+  // col2 is a nullable INTEGER column: compared to an INTEGER constant, the predicate runs on the raw integers;
+  // compared to a BIGINT constant, it goes through Values. Both must agree, and leave out NULLs.
+  auto *int_const = MakeConstantValueExpression(ValueFactory::GetIntegerValue(5));
+  auto *bigint_const = MakeConstantValueExpression(ValueFactory::GetBigIntValue(5));
+  std::vector<std::vector<int16_t>> results;
+  for (auto *constant : {int_const, bigint_const}) {
+    auto *predicate = MakeComparisonExpression(col2, constant, ComparisonType::LessThan);
+    SeqScanPlanNode plan{out_schema, predicate, table_info->oid_};
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &plan);
+    executor->Init();
+
+    results.emplace_back();
+    VectorBatch batch;
+    while (executor->NextBatch(&batch)) {
+      ASSERT_LE(batch.NumRows(), VECTOR_BATCH_SIZE);
+      ASSERT_GT(batch.NumSelected(), 0);
+      for (auto row : batch.GetSelection()) {
+        Value value = batch.GetColumn(1).GetValue(row);
+        ASSERT_FALSE(value.IsNull());
+        ASSERT_LT(value.GetAs<int32_t>(), 5);
+        results.back().emplace_back(batch.GetColumn(0).GetValue(row).GetAs<int16_t>());
+      }
+    }
+  }
+  ASSERT_FALSE(results[0].empty());
+  ASSERT_LT(results[0].size(), TEST2_SIZE);
+  ASSERT_EQ(results[0], results[1]);
+}
+
+// SELECT a.colA, b.colA FROM test_1 a JOIN test_1 b ON a.colB = b.colB, pulled a batch at a time
+TEST_F(ExecutorTest, BatchHashJoinTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto *scan_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+  auto left_plan = std::make_unique<SeqScanPlanNode>(scan_schema, nullptr, table_info->oid_);
+  auto right_plan = std::make_unique<SeqScanPlanNode>(scan_schema, nullptr, table_info->oid_);
+
+  auto *left_col_a = MakeColumnValueExpression(*scan_schema, 0, "colA");
+  auto *left_col_b = MakeColumnValueExpression(*scan_schema, 0, "colB");
+  auto *right_col_a = MakeColumnValueExpression(*scan_schema, 1, "colA");
+  auto *right_col_b = MakeColumnValueExpression(*scan_schema, 1, "colB");
+  auto *out_schema = MakeOutputSchema(
+      {{"left_colA", left_col_a}, {"left_colB", left_col_b}, {"right_colA", right_col_a}, {"right_colB", right_col_b}});
+  HashJoinPlanNode join_plan{out_schema, std::vector<const AbstractPlanNode *>{left_plan.get(), right_plan.get()},
+                             left_col_b, right_col_b};
+
+  // Every one of the ~100000 output rows pairs up rows with the same colB; the output spans many batches.
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &join_plan);
+  executor->Init();
+  size_t num_batch_rows = 0;
+  size_t num_batches = 0;
+  VectorBatch batch;
+  while (executor->NextBatch(&batch)) {
+    ASSERT_LE(batch.NumRows(), VECTOR_BATCH_SIZE);
+    for (auto row : batch.GetSelection()) {
+      ASSERT_EQ(batch.GetColumn(1).GetValue(row).GetAs<int32_t>(), batch.GetColumn(3).GetValue(row).GetAs<int32_t>());
+    }
+    num_batch_rows += batch.NumSelected();
+    num_batches++;
+  }
+  ASSERT_GT(num_batches, 1);
+
+  // The tuple-at-a-time join produces as many rows.
+  executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &join_plan);
+  executor->Init();
+  size_t num_rows = 0;
+  Tuple tuple;
+  RID rid;
+  while (executor->Next(&tuple, &rid)) {
+    num_rows++;
+  }
+  ASSERT_EQ(num_rows, num_batch_rows);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, ParallelQueryTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  // Grow the table to several morsels; the new rows fail the filter and add no groups.
+  for (int32_t i = 0; i < 9000; i++) {
+    Tuple tuple{std::vector<Value>{ValueFactory::GetIntegerValue(TEST1_SIZE + i), ValueFactory::GetIntegerValue(i % 10),
+                                   ValueFactory::GetIntegerValue(0), ValueFactory::GetIntegerValue(0)},
+                &schema};
+    RID rid;
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+  ASSERT_GT(table_info->table_->GetMorsels(MORSEL_SIZE).size(), 2);
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto *const500 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(500));
+  auto *predicate = MakeComparisonExpression(col_a, const500, ComparisonType::LessThan);
+  auto *scan_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+  SeqScanPlanNode filter_plan{scan_schema, predicate, table_info->oid_};
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+
+  // SELECT colB, COUNT(colA), SUM(colA), MIN(colA), MAX(colA) FROM test_1 GROUP BY colB
+  auto *group_b = MakeColumnValueExpression(*scan_schema, 0, "colB");
+  auto *agg_a = MakeColumnValueExpression(*scan_schema, 0, "colA");
+  auto *agg_schema =
+      MakeOutputSchema({{"colB", MakeAggregateValueExpression(true, 0)},
+                        {"count_a", MakeAggregateValueExpression(false, 0)},
+                        {"sum_a", MakeAggregateValueExpression(false, 1)},
+                        {"min_a", MakeAggregateValueExpression(false, 2)},
+                        {"max_a", MakeAggregateValueExpression(false, 3)}});
+  AggregationPlanNode agg_plan{agg_schema,
+                               &scan_plan,
+                               nullptr,
+                               std::vector<const AbstractExpression *>{group_b},
+                               std::vector<const AbstractExpression *>{agg_a, agg_a, agg_a, agg_a},
+                               std::vector<AggregationType>{
+                                   AggregationType::CountAggregate, AggregationType::SumAggregate,
+                                   AggregationType::MinAggregate, AggregationType::MaxAggregate}};
+
+  // SELECT colA, COUNT(colB) FROM test_1 GROUP BY colA, whose groups are spread over all hash ranges of the merge
+  auto *group_a_schema = MakeOutputSchema(
+      {{"colA", MakeAggregateValueExpression(true, 0)}, {"count_b", MakeAggregateValueExpression(false, 0)}});
+  AggregationPlanNode group_a_plan{group_a_schema,
+                                   &scan_plan,
+                                   nullptr,
+                                   std::vector<const AbstractExpression *>{agg_a},
+                                   std::vector<const AbstractExpression *>{group_b},
+                                   std::vector<AggregationType>{AggregationType::CountAggregate}};
+
+  // SELECT l.colA, r.colA FROM test_1 l JOIN test_1 r ON l.colB = r.colB WHERE r.colA < 500
+  auto *join_schema = MakeOutputSchema({{"left_colA", MakeColumnValueExpression(*scan_schema, 0, "colA")},
+                                        {"right_colA", MakeColumnValueExpression(*scan_schema, 1, "colA")}});
+  HashJoinPlanNode join_plan{join_schema, std::vector<const AbstractPlanNode *>{&scan_plan, &filter_plan},
+                             MakeColumnValueExpression(*scan_schema, 0, "colB"),
+                             MakeColumnValueExpression(*scan_schema, 1, "colB")};
+
+  // Scenario: each query produces the same rows on four threads as on one, in some order.
+  for (const AbstractPlanNode *plan :
+       std::vector<const AbstractPlanNode *>{&filter_plan, &agg_plan, &group_a_plan, &join_plan}) {
+    auto serial_rows = SortedRows(plan, 1);
+    auto parallel_rows = SortedRows(plan, 4);
+    ASSERT_FALSE(serial_rows.empty());
+    ASSERT_EQ(serial_rows, parallel_rows);
+  }
+  ASSERT_EQ(500, SortedRows(&filter_plan, 4).size());
+  ASSERT_EQ(10, SortedRows(&agg_plan, 4).size());
+  ASSERT_EQ(TEST1_SIZE + 9000, SortedRows(&group_a_plan, 4).size());
+  GetExecutorContext()->SetParallelism(1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, GraceHashJoinTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_c = MakeColumnValueExpression(schema, 0, "colC");
+  auto *scan_schema = MakeOutputSchema({{"colA", col_a}, {"colC", col_c}});
+  SeqScanPlanNode left_plan{scan_schema, nullptr, table_info->oid_};
+  SeqScanPlanNode right_plan{scan_schema, nullptr, table_info->oid_};
+
+  // SELECT l.colA, r.colA FROM test_1 l JOIN test_1 r ON l.colC = r.colC
+  auto *join_schema = MakeOutputSchema({{"left_colA", MakeColumnValueExpression(*scan_schema, 0, "colA")},
+                                        {"right_colA", MakeColumnValueExpression(*scan_schema, 1, "colA")}});
+  HashJoinPlanNode join_plan{join_schema, std::vector<const AbstractPlanNode *>{&left_plan, &right_plan},
+                             MakeColumnValueExpression(*scan_schema, 0, "colC"),
+                             MakeColumnValueExpression(*scan_schema, 1, "colC")};
+
+  auto run = [&](size_t memory_budget) {
+    GetExecutorContext()->SetMemoryBudget(memory_budget);
+    return SortedRows(&join_plan);
+  };
+
+  // Scenario: the join spills its inputs to partitions, which are split further when the budget is tiny, and produces
+  // the same rows as in memory.
+  auto in_memory_rows = run(OPERATOR_MEMORY_BUDGET);
+  ASSERT_GE(in_memory_rows.size(), TEST1_SIZE);
+  ASSERT_EQ(in_memory_rows, run(2000));
+  ASSERT_EQ(in_memory_rows, run(100));
+
+  // Scenario: the tuple-at-a-time join spills the same way.
+  GetExecutorContext()->SetMemoryBudget(2000);
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &join_plan);
+  executor->Init();
+  size_t num_rows = 0;
+  Tuple tuple;
+  RID rid;
+  while (executor->Next(&tuple, &rid)) {
+    num_rows++;
+  }
+  ASSERT_EQ(in_memory_rows.size(), num_rows);
+
+  // Scenario: initializing the drained join again runs it again from scratch, spilled or not.
+  for (size_t memory_budget : {static_cast<size_t>(2000), OPERATOR_MEMORY_BUDGET}) {
+    GetExecutorContext()->SetMemoryBudget(memory_budget);
+    for (int pass = 0; pass < 2; pass++) {
+      executor->Init();
+      num_rows = 0;
+      while (executor->Next(&tuple, &rid)) {
+        num_rows++;
+      }
+      ASSERT_EQ(in_memory_rows.size(), num_rows);
+    }
+  }
+  GetExecutorContext()->SetMemoryBudget(OPERATOR_MEMORY_BUDGET);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, RadixHashJoinTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto *col_c = MakeColumnValueExpression(schema, 0, "colC");
+  auto *scan_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}, {"colC", col_c}});
+  SeqScanPlanNode left_plan{scan_schema, nullptr, table_info->oid_};
+  SeqScanPlanNode right_plan{scan_schema, nullptr, table_info->oid_};
+  auto *join_schema = MakeOutputSchema({{"left_colA", MakeColumnValueExpression(*scan_schema, 0, "colA")},
+                                        {"right_colA", MakeColumnValueExpression(*scan_schema, 1, "colA")}});
+
+  // Scenario: for joins on a key with few (colB) and many (colC) distinct values, the radix-partitioned join produces
+  // the same rows as the simple hash join, serially and in parallel.
+  for (uint32_t key_idx : {1U, 2U}) {
+    auto *left_key = MakeColumnValueExpression(*scan_schema, 0, scan_schema->GetColumn(key_idx).GetName());
+    auto *right_key = MakeColumnValueExpression(*scan_schema, 1, scan_schema->GetColumn(key_idx).GetName());
+    HashJoinPlanNode simple_plan{join_schema, std::vector<const AbstractPlanNode *>{&left_plan, &right_plan}, left_key,
+                                 right_key};
+    HashJoinPlanNode radix_plan{join_schema,
+                                std::vector<const AbstractPlanNode *>{&left_plan, &right_plan},
+                                left_key,
+                                right_key,
+                                HashJoinAlgorithm::RadixPartitioned};
+    auto expected = SortedRows(&simple_plan, 1);
+    ASSERT_GE(expected.size(), TEST1_SIZE);
+    ASSERT_EQ(expected, SortedRows(&radix_plan, 1));
+    ASSERT_EQ(expected, SortedRows(&radix_plan, 4));
+  }
+  GetExecutorContext()->SetParallelism(1);
+}
+
+// SELECT colC, count(colA), sum(colA), min(colA), max(colA) FROM test_1 GROUP BY colC HAVING max(colA) > 500
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, SpillAggregationTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_c = MakeColumnValueExpression(schema, 0, "colC");
+  auto *scan_schema = MakeOutputSchema({{"colA", col_a}, {"colC", col_c}});
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+
+  const AbstractExpression *agg_a = MakeColumnValueExpression(*scan_schema, 0, "colA");
+  const AbstractExpression *group_by_c = MakeColumnValueExpression(*scan_schema, 0, "colC");
+  const AbstractExpression *max_a = MakeAggregateValueExpression(false, 3);
+  const AbstractExpression *having = MakeComparisonExpression(
+      max_a, MakeConstantValueExpression(ValueFactory::GetIntegerValue(500)), ComparisonType::GreaterThan);
+  auto *agg_schema = MakeOutputSchema({{"colC", MakeAggregateValueExpression(true, 0)},
+                                       {"count_a", MakeAggregateValueExpression(false, 0)},
+                                       {"sum_a", MakeAggregateValueExpression(false, 1)},
+                                       {"min_a", MakeAggregateValueExpression(false, 2)},
+                                       {"max_a", max_a}});
+  AggregationPlanNode agg_plan{agg_schema,
+                               &scan_plan,
+                               having,
+                               std::vector<const AbstractExpression *>{group_by_c},
+                               std::vector<const AbstractExpression *>{agg_a, agg_a, agg_a, agg_a},
+                               std::vector<AggregationType>{AggregationType::CountAggregate,
+                                                            AggregationType::SumAggregate,
+                                                            AggregationType::MinAggregate,
+                                                            AggregationType::MaxAggregate}};
+
+  auto run = [&](size_t memory_budget, size_t parallelism) {
+    GetExecutorContext()->SetMemoryBudget(memory_budget);
+    return SortedRows(&agg_plan, parallelism);
+  };
+
+  // Scenario: the aggregation spills partial groups to partitions, which are split further when the budget is tiny,
+  // and produces the same groups as in memory, serially and in parallel.
+  auto in_memory_rows = run(OPERATOR_MEMORY_BUDGET, 1);
+  ASSERT_FALSE(in_memory_rows.empty());
+  ASSERT_EQ(in_memory_rows, run(2000, 1));
+  ASSERT_EQ(in_memory_rows, run(100, 1));
+  ASSERT_EQ(in_memory_rows, run(2000, 4));
+  ASSERT_EQ(in_memory_rows, run(100, 4));
+  GetExecutorContext()->SetMemoryBudget(OPERATOR_MEMORY_BUDGET);
+  GetExecutorContext()->SetParallelism(1);
+}
+
+// SELECT colA, colB FROM test_1 ORDER BY colB ASC, colA DESC
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, SortTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto *scan_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+  SortPlanNode sort_plan{scan_schema,
+                         &scan_plan,
+                         {{OrderByType::Asc, MakeColumnValueExpression(*scan_schema, 0, "colB")},
+                          {OrderByType::Desc, MakeColumnValueExpression(*scan_schema, 0, "colA")}}};
+
+  std::vector<std::pair<int32_t, int32_t>> expected;
+  {
+    std::vector<Tuple> result_set;
+    ASSERT_TRUE(GetExecutionEngine()->Execute(&scan_plan, &result_set, GetTxn(), GetExecutorContext()));
+    for (const auto &tuple : result_set) {
+      expected.emplace_back(tuple.GetValue(scan_schema, 1).GetAs<int32_t>(),
+                            -tuple.GetValue(scan_schema, 0).GetAs<int32_t>());
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(TEST1_SIZE, expected.size());
+  }
+  auto check = [&](const std::vector<Tuple> &result_set) {
+    ASSERT_EQ(expected.size(), result_set.size());
+    for (size_t i = 0; i < result_set.size(); i++) {
+      ASSERT_EQ(expected[i].first, result_set[i].GetValue(scan_schema, 1).GetAs<int32_t>());
+      ASSERT_EQ(-expected[i].second, result_set[i].GetValue(scan_schema, 0).GetAs<int32_t>());
+    }
+  };
+
+  // Scenario: the tuples are sorted in memory, or in runs merged in one pass (2000 bytes) or in several (100 bytes).
+  for (size_t memory_budget : {OPERATOR_MEMORY_BUDGET, static_cast<size_t>(2000), static_cast<size_t>(100)}) {
+    GetExecutorContext()->SetMemoryBudget(memory_budget);
+    std::vector<Tuple> result_set;
+    ASSERT_TRUE(GetExecutionEngine()->Execute(&sort_plan, &result_set, GetTxn(), GetExecutorContext()));
+    check(result_set);
+  }
+
+  // Scenario: the tuple-at-a-time sort merges the same way.
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &sort_plan);
+  executor->Init();
+  std::vector<Tuple> result_set;
+  Tuple tuple;
+  RID rid;
+  while (executor->Next(&tuple, &rid)) {
+    result_set.push_back(tuple);
+  }
+  check(result_set);
+  GetExecutorContext()->SetMemoryBudget(OPERATOR_MEMORY_BUDGET);
+}
+
+// SELECT colA, colB, colD FROM test_1 ORDER BY ... LIMIT n
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, TopNTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto *scan_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(schema, 0, "colA")},
+                                        {"colB", MakeColumnValueExpression(schema, 0, "colB")},
+                                        {"colD", MakeColumnValueExpression(schema, 0, "colD")}});
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+
+  // Scenario: ORDER BY colD DESC, colA, whose keys are unique, gives the same rows as a sort followed by a limit,
+  // serially and in parallel, and whether n is small, zero, or beyond the size of the table.
+  std::vector<OrderBy> unique_order{{OrderByType::Desc, MakeColumnValueExpression(*scan_schema, 0, "colD")},
+                                    {OrderByType::Asc, MakeColumnValueExpression(*scan_schema, 0, "colA")}};
+  SortPlanNode sort_plan{scan_schema, &scan_plan, unique_order};
+  for (size_t n : {static_cast<size_t>(50), static_cast<size_t>(0), static_cast<size_t>(TEST1_SIZE + 1)}) {
+    LimitPlanNode limit_plan{scan_schema, &sort_plan, n};
+    TopNPlanNode topn_plan{scan_schema, &scan_plan, unique_order, n};
+    auto expected = ExecuteRows(&limit_plan, 1);
+    ASSERT_EQ(std::min<size_t>(n, TEST1_SIZE), expected.size());
+    ASSERT_EQ(expected, ExecuteRows(&topn_plan, 1));
+    ASSERT_EQ(expected, ExecuteRows(&topn_plan, 4));
+  }
+
+  // Scenario: ORDER BY colB, which has many ties, keeps the tuples that come first in the input, like a stable sort.
+  std::vector<OrderBy> tied_order{{OrderByType::Asc, MakeColumnValueExpression(*scan_schema, 0, "colB")}};
+  SortPlanNode tied_sort_plan{scan_schema, &scan_plan, tied_order};
+  LimitPlanNode tied_limit_plan{scan_schema, &tied_sort_plan, 50};
+  TopNPlanNode tied_topn_plan{scan_schema, &scan_plan, tied_order, 50};
+  ASSERT_EQ(ExecuteRows(&tied_limit_plan, 1), ExecuteRows(&tied_topn_plan, 1));
+  GetExecutorContext()->SetParallelism(1);
+}
+
+// SELECT l.colA, r.colA FROM test_1 l JOIN test_1 r ON l.key = r.key, with both sides sorted on the key
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, MergeJoinTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  // Add a few rows with NULL keys, which join with nothing.
+  for (int32_t i = 0; i < 5; i++) {
+    Value null_value = ValueFactory::GetNullValueByType(TypeId::INTEGER);
+    Tuple tuple{std::vector<Value>{ValueFactory::GetIntegerValue(TEST1_SIZE + i), null_value, null_value,
+                                   ValueFactory::GetIntegerValue(0)},
+                &schema};
+    RID rid;
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+  auto *scan_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(schema, 0, "colA")},
+                                        {"colB", MakeColumnValueExpression(schema, 0, "colB")},
+                                        {"colC", MakeColumnValueExpression(schema, 0, "colC")}});
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+  auto *join_schema = MakeOutputSchema({{"left_colA", MakeColumnValueExpression(*scan_schema, 0, "colA")},
+                                        {"right_colA", MakeColumnValueExpression(*scan_schema, 1, "colA")}});
+  // Scenario: for keys with long runs of duplicates on both sides (colB) and with short ones (colC), the merge join
+  // produces the same rows as the hash join.
+  for (const char *key : {"colB", "colC"}) {
+    auto *left_key = MakeColumnValueExpression(*scan_schema, 0, key);
+    auto *right_key = MakeColumnValueExpression(*scan_schema, 1, key);
+    SortPlanNode sort_plan{scan_schema, &scan_plan,
+                           {{OrderByType::Asc, MakeColumnValueExpression(*scan_schema, 0, key)}}};
+    MergeJoinPlanNode merge_plan{join_schema, std::vector<const AbstractPlanNode *>{&sort_plan, &sort_plan}, left_key,
+                                 right_key};
+    HashJoinPlanNode hash_plan{join_schema, std::vector<const AbstractPlanNode *>{&scan_plan, &scan_plan}, left_key,
+                               right_key};
+    auto expected = SortedRows(&hash_plan);
+    ASSERT_GE(expected.size(), TEST1_SIZE);
+    ASSERT_EQ(expected, SortedRows(&merge_plan));
+  }
+
+  // Scenario: a side with no tuples joins with nothing.
+  auto *empty_info = GetExecutorContext()->GetCatalog()->GetTable("empty_table");
+  auto *empty_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(empty_info->schema_, 0, "colA")}});
+  SeqScanPlanNode empty_plan{empty_schema, nullptr, empty_info->oid_};
+  MergeJoinPlanNode empty_join_plan{join_schema, std::vector<const AbstractPlanNode *>{&scan_plan, &empty_plan},
+                                    MakeColumnValueExpression(*scan_schema, 0, "colA"),
+                                    MakeColumnValueExpression(*empty_schema, 1, "colA")};
+  ASSERT_TRUE(SortedRows(&empty_join_plan).empty());
+}
+
+// SELECT o.colA, i.colA FROM test_1 o JOIN test_1 i ON o.colC = i.colC, probing an index on i.colC
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, NestedIndexJoinTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto key_schema = ParseCreateStatement("c integer");
+  GetExecutorContext()->GetCatalog()->CreateIndex<KeyType, ValueType, ComparatorType>(
+      GetTxn(), "index_c", "test_1", schema, *key_schema, {2}, 8, HashFunctionType{});
+
+  auto *outer_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(schema, 0, "colA")},
+                                         {"colC", MakeColumnValueExpression(schema, 0, "colC")}});
+  SeqScanPlanNode outer_plan{outer_schema, nullptr, table_info->oid_};
+  auto *join_schema = MakeOutputSchema({{"outer_colA", MakeColumnValueExpression(*outer_schema, 0, "colA")},
+                                        {"inner_colA", MakeColumnValueExpression(schema, 1, "colA")}});
+  auto *predicate = MakeComparisonExpression(MakeColumnValueExpression(*outer_schema, 0, "colC"),
+                                             MakeColumnValueExpression(schema, 1, "colC"), ComparisonType::Equal);
+  NestedIndexJoinPlanNode index_join_plan{join_schema,
+                                          std::vector<const AbstractPlanNode *>{&outer_plan},
+                                          predicate,
+                                          table_info->oid_,
+                                          "index_c",
+                                          outer_schema,
+                                          &schema};
+  SeqScanPlanNode inner_plan{outer_schema, nullptr, table_info->oid_};
+  HashJoinPlanNode hash_plan{join_schema, std::vector<const AbstractPlanNode *>{&outer_plan, &inner_plan},
+                             MakeColumnValueExpression(*outer_schema, 0, "colC"),
+                             MakeColumnValueExpression(*outer_schema, 1, "colC")};
+
+  // Scenario: probing the index with sorted batches of outer keys, some repeated, gives the same rows as the hash join.
+  auto expected = SortedRows(&hash_plan);
+  ASSERT_GE(expected.size(), TEST1_SIZE);
+  ASSERT_EQ(expected, SortedRows(&index_join_plan));
+
+  // Scenario: the tuple-at-a-time join produces the same number of rows.
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &index_join_plan);
+  executor->Init();
+  size_t num_rows = 0;
+  Tuple tuple;
+  RID rid;
+  while (executor->Next(&tuple, &rid)) {
+    num_rows++;
+  }
+  ASSERT_EQ(expected.size(), num_rows);
+}
+
+// SELECT colA, colC FROM test_1 WHERE <bounds on colC>, with an index on colC
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, IndexScanTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto key_schema = ParseCreateStatement("c integer");
+  auto *index_info = GetExecutorContext()->GetCatalog()->CreateIndex<KeyType, ValueType, ComparatorType>(
+      GetTxn(), "index_c", "test_1", schema, *key_schema, {2}, 8, HashFunctionType{});
+
+  auto *col_c = MakeColumnValueExpression(schema, 0, "colC");
+  auto *out_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(schema, 0, "colA")}, {"colC", col_c}});
+  SeqScanPlanNode seq_plan{out_schema, nullptr, table_info->oid_};
+  std::vector<Tuple> all_rows;
+  GetExecutionEngine()->Execute(&seq_plan, &all_rows, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(TEST1_SIZE, all_rows.size());
+  auto expect = [&](const std::function<bool(int32_t a, int32_t c)> &keep) {
+    std::vector<std::string> rows;
+    for (const auto &tuple : all_rows) {
+      if (keep(tuple.GetValue(out_schema, 0).GetAs<int32_t>(), tuple.GetValue(out_schema, 1).GetAs<int32_t>())) {
+        rows.emplace_back(tuple.ToString(out_schema));
+      }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  };
+  auto scan = [&](const std::vector<const AbstractExpression *> &conjuncts) {
+    std::optional<IndexKeyBound> lower;
+    std::optional<IndexKeyBound> upper;
+    EXPECT_TRUE(IndexBoundsUtil::DeriveBounds(conjuncts, 2, &lower, &upper));
+    return std::make_unique<IndexScanPlanNode>(out_schema, nullptr, index_info->index_oid_, lower, upper);
+  };
+
+  // Scenario: an equality on the key is a single probe of the index.
+  int32_t key = all_rows[0].GetValue(out_schema, 1).GetAs<int32_t>();
+  auto *equal = MakeComparisonExpression(col_c, MakeConstantValueExpression(ValueFactory::GetIntegerValue(key)),
+                                         ComparisonType::Equal);
+  auto point_rows = SortedRows(scan({equal}).get());
+  ASSERT_FALSE(point_rows.empty());
+  ASSERT_EQ(expect([&](int32_t a, int32_t c) { return c == key; }), point_rows);
+
+  // Scenario: a range the hash index cannot serve still returns exactly the tuples in range.
+  auto *lower = MakeComparisonExpression(MakeConstantValueExpression(ValueFactory::GetIntegerValue(2000)), col_c,
+                                         ComparisonType::LessThanOrEqual);
+  auto *upper = MakeComparisonExpression(col_c, MakeConstantValueExpression(ValueFactory::GetIntegerValue(5000)),
+                                         ComparisonType::LessThan);
+  auto range_rows = SortedRows(scan({lower, upper}).get());
+  ASSERT_FALSE(range_rows.empty());
+  ASSERT_EQ(expect([](int32_t a, int32_t c) { return c >= 2000 && c < 5000; }), range_rows);
+
+  // Scenario: the predicate applies on top of the bounds.
+  auto *below_half = MakeComparisonExpression(MakeColumnValueExpression(schema, 0, "colA"),
+                                              MakeConstantValueExpression(ValueFactory::GetIntegerValue(500)),
+                                              ComparisonType::LessThan);
+  IndexScanPlanNode filtered_plan{out_schema, below_half, index_info->index_oid_,
+                                  IndexKeyBound{ValueFactory::GetIntegerValue(2000), true},
+                                  IndexKeyBound{ValueFactory::GetIntegerValue(5000), false}};
+  ASSERT_EQ(expect([](int32_t a, int32_t c) { return a < 500 && c >= 2000 && c < 5000; }), SortedRows(&filtered_plan));
+
+  // Scenario: an equality excluded by a strict bound on the same key leaves an empty range.
+  auto *less = MakeComparisonExpression(col_c, MakeConstantValueExpression(ValueFactory::GetIntegerValue(key)),
+                                        ComparisonType::LessThan);
+  ASSERT_TRUE(SortedRows(scan({equal, less}).get()).empty());
+}
+
 }  // namespace bustub
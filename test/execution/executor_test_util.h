@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cstdio>
 #include <memory>
 #include <string>
@@ -99,6 +100,36 @@ class ExecutorTest : public ::testing::Test {
   /** @return The lock manager for our test instance. */
   LockManager *GetLockManager() { return lock_manager_.get(); }
 
+  /**
+   * Execute a query plan and render the rows it produces.
+   * @param plan The query plan to execute
+   * @param parallelism The number of threads the query may run on
+   * @return The rows produced by the plan, as strings, in the order they were produced
+   */
+  std::vector<std::string> ExecuteRows(const AbstractPlanNode *plan, size_t parallelism = 1) {
+    GetExecutorContext()->SetParallelism(parallelism);
+    std::vector<Tuple> result_set;
+    EXPECT_TRUE(GetExecutionEngine()->Execute(plan, &result_set, GetTxn(), GetExecutorContext()));
+    std::vector<std::string> rows;
+    for (const auto &tuple : result_set) {
+      rows.emplace_back(tuple.ToString(plan->OutputSchema()));
+    }
+    return rows;
+  }
+
+  /**
+   * Execute a query plan and render the rows it produces in sorted order, to compare plans that produce the same rows
+   * in different orders.
+   * @param plan The query plan to execute
+   * @param parallelism The number of threads the query may run on
+   * @return The rows produced by the plan, as sorted strings
+   */
+  std::vector<std::string> SortedRows(const AbstractPlanNode *plan, size_t parallelism = 1) {
+    std::vector<std::string> rows = ExecuteRows(plan, parallelism);
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
   /**
    * Make a column value expression.
    * @param schema The schema for the expression
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_bounds_test.cpp
+//
+// Identification: test/execution/index_bounds_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/index_bounds.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(IndexBoundsTest, DeriveBoundsTest) {
+  ColumnValueExpression col_a{0, 0, TypeId::INTEGER};
+  ColumnValueExpression col_b{0, 1, TypeId::INTEGER};
+  ConstantValueExpression three{ValueFactory::GetIntegerValue(3)};
+  ConstantValueExpression five{ValueFactory::GetIntegerValue(5)};
+  ConstantValueExpression eight{ValueFactory::GetIntegerValue(8)};
+  ConstantValueExpression null{ValueFactory::GetNullValueByType(TypeId::INTEGER)};
+  auto bound_equals = [](const std::optional<IndexKeyBound> &bound, int32_t key, bool inclusive) {
+    return bound.has_value() && bound->key_.GetAs<int32_t>() == key && bound->inclusive_ == inclusive;
+  };
+
+  {
+    // Scenario: a > 3 AND a <= 8 bounds a on both ends.
+    ComparisonExpression greater{&col_a, &three, ComparisonType::GreaterThan};
+    ComparisonExpression less_equal{&col_a, &eight, ComparisonType::LessThanOrEqual};
+    std::optional<IndexKeyBound> lower;
+    std::optional<IndexKeyBound> upper;
+    EXPECT_TRUE(IndexBoundsUtil::DeriveBounds({&greater, &less_equal}, 0, &lower, &upper));
+    EXPECT_TRUE(bound_equals(lower, 3, false));
+    EXPECT_TRUE(bound_equals(upper, 8, true));
+  }
+
+  {
+    // Scenario: a constant on the left turns the comparison around: 5 > a is a < 5, and 3 <= a is a >= 3.
+    ComparisonExpression greater{&five, &col_a, ComparisonType::GreaterThan};
+    ComparisonExpression less_equal{&three, &col_a, ComparisonType::LessThanOrEqual};
+    std::optional<IndexKeyBound> lower;
+    std::optional<IndexKeyBound> upper;
+    EXPECT_TRUE(IndexBoundsUtil::DeriveBounds({&greater, &less_equal}, 0, &lower, &upper));
+    EXPECT_TRUE(bound_equals(lower, 3, true));
+    EXPECT_TRUE(bound_equals(upper, 5, false));
+  }
+
+  {
+    // Scenario: the tightest bound wins, and an exclusive bound is tighter than an inclusive one on the same key.
+    ComparisonExpression less_eight{&col_a, &eight, ComparisonType::LessThan};
+    ComparisonExpression less_equal_five{&col_a, &five, ComparisonType::LessThanOrEqual};
+    ComparisonExpression less_five{&col_a, &five, ComparisonType::LessThan};
+    ComparisonExpression equal_five{&col_a, &five, ComparisonType::Equal};
+    std::optional<IndexKeyBound> lower;
+    std::optional<IndexKeyBound> upper;
+    EXPECT_TRUE(IndexBoundsUtil::DeriveBounds({&less_eight, &less_equal_five, &less_five, &equal_five}, 0, &lower,
+                                              &upper));
+    EXPECT_TRUE(bound_equals(lower, 5, true));
+    EXPECT_TRUE(bound_equals(upper, 5, false));
+    EXPECT_FALSE(IndexBoundsUtil::IsBelowUpper(ValueFactory::GetIntegerValue(5), upper));
+    EXPECT_TRUE(IndexBoundsUtil::IsAboveLower(ValueFactory::GetIntegerValue(5), lower));
+  }
+
+  {
+    // Scenario: comparisons on other columns, inequalities, comparisons with NULL and of two columns bound nothing.
+    ComparisonExpression other_column{&col_b, &three, ComparisonType::Equal};
+    ComparisonExpression not_equal{&col_a, &three, ComparisonType::NotEqual};
+    ComparisonExpression with_null{&col_a, &null, ComparisonType::LessThan};
+    ComparisonExpression two_columns{&col_a, &col_b, ComparisonType::Equal};
+    std::optional<IndexKeyBound> lower;
+    std::optional<IndexKeyBound> upper;
+    EXPECT_FALSE(
+        IndexBoundsUtil::DeriveBounds({&other_column, &not_equal, &with_null, &two_columns}, 0, &lower, &upper));
+    EXPECT_FALSE(lower.has_value());
+    EXPECT_FALSE(upper.has_value());
+    EXPECT_TRUE(IndexBoundsUtil::IsAboveLower(ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX), lower));
+    EXPECT_TRUE(IndexBoundsUtil::IsBelowUpper(ValueFactory::GetIntegerValue(-5), upper));
+  }
+}
+
+}  // namespace bustub
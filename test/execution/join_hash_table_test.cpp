@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table_test.cpp
+//
+// Identification: test/execution/join_hash_table_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <map>
+#include <vector>
+
+#include "execution/join_hash_table.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(JoinHashTableTest, InsertFindTest) {
+  Schema schema{std::vector<Column>{Column{"key", TypeId::INTEGER}, Column{"val", TypeId::INTEGER}}};
+  JoinHashTable ht;
+  EXPECT_TRUE(ht.IsEmpty());
+
+  // Scenario: many keys with several tuples each, and a NULL key that is dropped.
+  const int32_t num_keys = 1000;
+  const int32_t num_dups = 3;
+  for (int32_t dup = 0; dup < num_dups; dup++) {
+    for (int32_t key = 0; key < num_keys; key++) {
+      Value value = ValueFactory::GetIntegerValue(key);
+      ht.Insert(HashUtil::HashValue(&value), value,
+                Tuple{{value, ValueFactory::GetIntegerValue(dup)}, &schema});
+    }
+  }
+  Value null_value = ValueFactory::GetNullValueByType(TypeId::INTEGER);
+  ht.Insert(HashUtil::HashValue(&null_value), null_value, Tuple{{null_value, null_value}, &schema});
+  EXPECT_EQ(JoinHashTable::NO_ENTRY, ht.Find(HashUtil::HashValue(&null_value), null_value));
+
+  for (int32_t key = 0; key < num_keys; key++) {
+    Value value = ValueFactory::GetIntegerValue(key);
+    int32_t dups = 0;
+    for (uint32_t entry = ht.Find(HashUtil::HashValue(&value), value); entry != JoinHashTable::NO_ENTRY;
+         entry = ht.Next(entry)) {
+      EXPECT_EQ(key, ht.GetTuple(entry).GetValue(&schema, 0).GetAs<int32_t>());
+      dups++;
+    }
+    EXPECT_EQ(num_dups, dups);
+  }
+  Value missing = ValueFactory::GetIntegerValue(num_keys);
+  EXPECT_EQ(JoinHashTable::NO_ENTRY, ht.Find(HashUtil::HashValue(&missing), missing));
+
+  std::map<int32_t, int32_t> counts;
+  ht.ForEach([&](hash_t hash, const Tuple &tuple) {
+    Value key = tuple.GetValue(&schema, 0);
+    EXPECT_EQ(HashUtil::HashValue(&key), hash);
+    counts[key.GetAs<int32_t>()]++;
+  });
+  EXPECT_EQ(num_keys, counts.size());
+
+  ht.Clear();
+  EXPECT_TRUE(ht.IsEmpty());
+  EXPECT_EQ(0, ht.GetSize());
+}
+
+// NOLINTNEXTLINE
+TEST(JoinHashTableTest, CollisionTest) {
+  Schema schema{std::vector<Column>{Column{"key", TypeId::INTEGER}}};
+  JoinHashTable ht;
+
+  // Scenario: distinct keys with the same hash get slots of their own, and are told apart by their keys.
+  const hash_t hash = 42;
+  for (int32_t key = 0; key < 100; key++) {
+    Value value = ValueFactory::GetIntegerValue(key);
+    ht.Insert(hash, value, Tuple{{value}, &schema});
+  }
+  for (int32_t key = 0; key < 100; key++) {
+    Value value = ValueFactory::GetIntegerValue(key);
+    uint32_t entry = ht.Find(hash, value);
+    ASSERT_NE(JoinHashTable::NO_ENTRY, entry);
+    EXPECT_EQ(key, ht.GetTuple(entry).GetValue(&schema, 0).GetAs<int32_t>());
+    EXPECT_EQ(JoinHashTable::NO_ENTRY, ht.Next(entry));
+  }
+}
+
+}  // namespace bustub
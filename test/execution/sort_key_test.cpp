@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key_test.cpp
+//
+// Identification: test/execution/sort_key_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "execution/sort_key.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Check that the keys of values given in ascending order increase, and decrease when descending. */
+void ExpectOrdered(const std::vector<Value> &values) {
+  for (size_t i = 1; i < values.size(); i++) {
+    std::string prev_asc;
+    std::string asc;
+    SortKeyUtil::AppendValue(values[i - 1], OrderByType::Asc, &prev_asc);
+    SortKeyUtil::AppendValue(values[i], OrderByType::Asc, &asc);
+    EXPECT_LT(prev_asc, asc) << values[i - 1].ToString() << " vs " << values[i].ToString();
+    std::string prev_desc;
+    std::string desc;
+    SortKeyUtil::AppendValue(values[i - 1], OrderByType::Desc, &prev_desc);
+    SortKeyUtil::AppendValue(values[i], OrderByType::Desc, &desc);
+    EXPECT_GT(prev_desc, desc) << values[i - 1].ToString() << " vs " << values[i].ToString();
+  }
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(SortKeyTest, ValueOrderTest) {
+  // Scenario: for each type, NULL and then values in ascending order encode to increasing keys.
+  ExpectOrdered({ValueFactory::GetNullValueByType(TypeId::TINYINT), ValueFactory::GetTinyIntValue(-100),
+                 ValueFactory::GetTinyIntValue(-1), ValueFactory::GetTinyIntValue(0),
+                 ValueFactory::GetTinyIntValue(100)});
+  ExpectOrdered({ValueFactory::GetNullValueByType(TypeId::SMALLINT), ValueFactory::GetSmallIntValue(-30000),
+                 ValueFactory::GetSmallIntValue(-1), ValueFactory::GetSmallIntValue(0),
+                 ValueFactory::GetSmallIntValue(255), ValueFactory::GetSmallIntValue(256)});
+  ExpectOrdered({ValueFactory::GetNullValueByType(TypeId::INTEGER), ValueFactory::GetIntegerValue(BUSTUB_INT32_MIN),
+                 ValueFactory::GetIntegerValue(-65536), ValueFactory::GetIntegerValue(-1),
+                 ValueFactory::GetIntegerValue(0), ValueFactory::GetIntegerValue(1),
+                 ValueFactory::GetIntegerValue(65536), ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX)});
+  ExpectOrdered({ValueFactory::GetNullValueByType(TypeId::BIGINT), ValueFactory::GetBigIntValue(-(1LL << 40)),
+                 ValueFactory::GetBigIntValue(-1), ValueFactory::GetBigIntValue(0),
+                 ValueFactory::GetBigIntValue(1LL << 40)});
+  ExpectOrdered({ValueFactory::GetNullValueByType(TypeId::DECIMAL), ValueFactory::GetDecimalValue(-1e10),
+                 ValueFactory::GetDecimalValue(-2.5), ValueFactory::GetDecimalValue(-0.5),
+                 ValueFactory::GetDecimalValue(0), ValueFactory::GetDecimalValue(0.5),
+                 ValueFactory::GetDecimalValue(2.5), ValueFactory::GetDecimalValue(1e10)});
+  ExpectOrdered({ValueFactory::GetNullValueByType(TypeId::VARCHAR), ValueFactory::GetVarcharValue(""),
+                 ValueFactory::GetVarcharValue("a"), ValueFactory::GetVarcharValue(std::string("a\0", 2)),
+                 ValueFactory::GetVarcharValue("ab"), ValueFactory::GetVarcharValue("b"),
+                 ValueFactory::GetVarcharValue("\xFF")});
+  ExpectOrdered({ValueFactory::GetBooleanValue(false), ValueFactory::GetBooleanValue(true)});
+
+  // Scenario: -0.0 and 0.0 are equal, and so are their keys.
+  std::string negative_zero;
+  std::string zero;
+  SortKeyUtil::AppendValue(ValueFactory::GetDecimalValue(-0.0), OrderByType::Asc, &negative_zero);
+  SortKeyUtil::AppendValue(ValueFactory::GetDecimalValue(0.0), OrderByType::Asc, &zero);
+  EXPECT_EQ(zero, negative_zero);
+}
+
+// NOLINTNEXTLINE
+TEST(SortKeyTest, MultiColumnTest) {
+  // Scenario: keys of several columns order by the first column, then by the next ones, whatever their lengths.
+  auto key = [](const std::string &name, int32_t number) {
+    std::string key;
+    SortKeyUtil::AppendValue(ValueFactory::GetVarcharValue(name), OrderByType::Asc, &key);
+    SortKeyUtil::AppendValue(ValueFactory::GetIntegerValue(number), OrderByType::Desc, &key);
+    return key;
+  };
+  EXPECT_LT(key("a", 5), key("a", 3));
+  EXPECT_LT(key("a", -1), key("aa", 100));
+  EXPECT_LT(key("ab", 0), key("b", 0));
+  EXPECT_EQ(key("b", 7), key("b", 7));
+}
+
+}  // namespace bustub
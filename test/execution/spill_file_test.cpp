@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_file_test.cpp
+//
+// Identification: test/execution/spill_file_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "execution/spill_file.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(SpillFileTest, AppendReadTest) {
+  remove("test.db");
+  auto disk_manager = std::make_unique<DiskManager>("test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(5, disk_manager.get());
+  Schema schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 64}}};
+
+  {
+    // Scenario: a file of many pages, more than the buffer pool holds, is read back in the order it was written.
+    SpillFile file(bpm.get());
+    const int32_t num_tuples = 5000;
+    size_t size = 0;
+    for (int32_t i = 0; i < num_tuples; i++) {
+      Tuple tuple{{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(i % 50, 'x'))},
+                  &schema};
+      file.Append(tuple);
+      size += tuple.GetLength();
+    }
+    EXPECT_EQ(num_tuples, file.GetNumTuples());
+    EXPECT_EQ(size, file.GetSize());
+
+    for (int pass = 0; pass < 2; pass++) {
+      Tuple tuple;
+      int32_t i = 0;
+      while (file.Next(&tuple)) {
+        ASSERT_EQ(i, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+        ASSERT_EQ(std::string(i % 50, 'x'), tuple.GetValue(&schema, 1).ToString());
+        i++;
+      }
+      EXPECT_EQ(num_tuples, i);
+      EXPECT_FALSE(file.Next(&tuple));
+      file.Rewind();
+    }
+  }
+
+  // Scenario: an empty file reads nothing.
+  SpillFile file(bpm.get());
+  Tuple tuple;
+  EXPECT_FALSE(file.Next(&tuple));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+}
+
+}  // namespace bustub
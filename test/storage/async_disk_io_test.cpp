@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// async_disk_io_test.cpp
+//
+// Identification: test/storage/async_disk_io_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/disk/async_disk_io.h"
+
+namespace bustub {
+
+class AsyncDiskIOTest : public ::testing::Test {
+ protected:
+  // This function is called before every test.
+  void SetUp() override {
+    remove("test.db");
+    remove("test.log");
+  }
+
+  // This function is called after every test.
+  void TearDown() override {
+    remove("test.db");
+    for (int i = 1; i < 8; i++) {
+      remove(("test.db." + std::to_string(i)).c_str());
+    }
+    remove("test.log");
+  };
+};
+
+// Keep every page of the test in flight at once, then check what was written is read back.
+static void ReadWritePages(DiskManager *disk_manager, AsyncDiskIO *async_io) {
+  const int num_pages = 100;
+  std::vector<std::unique_ptr<char[]>> data;
+  std::vector<std::future<bool>> futures;
+  for (int i = 0; i < num_pages; i++) {
+    data.emplace_back(new char[PAGE_SIZE]);
+    std::memset(data.back().get(), i, PAGE_SIZE);
+    futures.emplace_back(async_io->SubmitWrite(i, data.back().get()));
+  }
+  // Completions can be polled as well as awaited.
+  while (futures.back().wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+  }
+  for (auto &future : futures) {
+    EXPECT_TRUE(future.get());
+  }
+  EXPECT_EQ(num_pages, disk_manager->GetNumWrites());
+
+  futures.clear();
+  std::vector<std::unique_ptr<char[]>> bufs;
+  for (int i = 0; i < num_pages; i++) {
+    bufs.emplace_back(new char[PAGE_SIZE]);
+    futures.emplace_back(async_io->SubmitRead(i, bufs.back().get()));
+  }
+  for (int i = 0; i < num_pages; i++) {
+    EXPECT_TRUE(futures[i].get());
+    EXPECT_EQ(0, std::memcmp(bufs[i].get(), data[i].get(), PAGE_SIZE));
+  }
+
+  // Scenario: a page past the end of the file reads as zeros.
+  char buf[PAGE_SIZE];
+  char zeros[PAGE_SIZE] = {0};
+  std::memset(buf, 1, sizeof(buf));
+  EXPECT_TRUE(async_io->SubmitRead(num_pages + 1, buf).get());
+  EXPECT_EQ(0, std::memcmp(buf, zeros, PAGE_SIZE));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AsyncDiskIOTest, ThreadPoolTest) {
+  DiskManager disk_manager("test.db");
+  {
+    ThreadPoolDiskIO async_io(&disk_manager, 4);
+    ReadWritePages(&disk_manager, &async_io);
+  }
+  disk_manager.ShutDown();
+}
+
+// NOLINTNEXTLINE
+TEST_F(AsyncDiskIOTest, DefaultBackendTest) {
+  DiskManager disk_manager("test.db");
+  {
+    // io_uring where the kernel supports it, the thread pool otherwise.
+    auto async_io = AsyncDiskIO::Create(&disk_manager, 8);
+    ReadWritePages(&disk_manager, async_io.get());
+  }
+  disk_manager.ShutDown();
+}
+
+// NOLINTNEXTLINE
+TEST_F(AsyncDiskIOTest, SegmentedTest) {
+  DiskManager disk_manager("test.db", 16);
+  {
+    auto async_io = AsyncDiskIO::Create(&disk_manager, 8);
+    ReadWritePages(&disk_manager, async_io.get());
+  }
+  disk_manager.ShutDown();
+}
+
+}  // namespace bustub
@@ -10,7 +10,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <sys/stat.h>
 #include <cstring>
+#include <thread>  // NOLINT
+#include <vector>
 
 #include "common/exception.h"
 #include "gtest/gtest.h"
@@ -29,6 +32,9 @@ class DiskManagerTest : public ::testing::Test {
   // This function is called after every test.
   void TearDown() override {
     remove("test.db");
+    remove("test.db.1");
+    remove("test.db.2");
+    remove("test.db.4");
     remove("test.log");
   };
 };
@@ -55,6 +61,121 @@ TEST_F(DiskManagerTest, ReadWritePageTest) {
   dm.ShutDown();
 }
 
+// NOLINTNEXTLINE
+TEST_F(DiskManagerTest, ConcurrentReadWritePageTest) {
+  const int num_threads = 8;
+  const int pages_per_thread = 32;
+  std::string db_file("test.db");
+  auto dm = DiskManager(db_file);
+
+  // Every thread writes and reads back its own interleaved set of pages at the same time as the others.
+  std::vector<std::thread> threads;
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&dm, tid] {
+      char buf[PAGE_SIZE];
+      char data[PAGE_SIZE];
+      for (int i = 0; i < pages_per_thread; i++) {
+        page_id_t page_id = i * num_threads + tid;
+        std::memset(data, page_id % 128, sizeof(data));
+        dm.WritePage(page_id, data);
+      }
+      for (int i = 0; i < pages_per_thread; i++) {
+        page_id_t page_id = i * num_threads + tid;
+        std::memset(data, page_id % 128, sizeof(data));
+        dm.ReadPage(page_id, buf);
+        EXPECT_EQ(std::memcmp(buf, data, sizeof(buf)), 0);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(num_threads * pages_per_thread, dm.GetNumWrites());
+
+  // Scenario: a page past the end of the file reads as zeros.
+  char buf[PAGE_SIZE];
+  char zeros[PAGE_SIZE] = {0};
+  std::memset(buf, 1, sizeof(buf));
+  dm.ReadPage(num_threads * pages_per_thread, buf);
+  EXPECT_EQ(std::memcmp(buf, zeros, sizeof(buf)), 0);
+
+  dm.ShutDown();
+}
+
+// NOLINTNEXTLINE
+TEST_F(DiskManagerTest, LargeOffsetTest) {
+  char buf[PAGE_SIZE] = {0};
+  char data[PAGE_SIZE] = {0};
+  std::string db_file("test.db");
+  auto dm = DiskManager(db_file);
+  std::strncpy(data, "A test string.", sizeof(data));
+
+  // The page starts past 4 GiB; the file is sparse up to it.
+  page_id_t page_id = (1 << 20) + 1;
+  dm.WritePage(page_id, data);
+  dm.ReadPage(page_id, buf);
+  EXPECT_EQ(std::memcmp(buf, data, sizeof(buf)), 0);
+
+  struct stat stat_buf;
+  ASSERT_EQ(0, stat("test.db", &stat_buf));
+  EXPECT_EQ(static_cast<int64_t>(page_id + 1) * PAGE_SIZE, static_cast<int64_t>(stat_buf.st_size));
+
+  dm.ShutDown();
+}
+
+// NOLINTNEXTLINE
+TEST_F(DiskManagerTest, SegmentedReadWriteTest) {
+  const size_t pages_per_segment = 4;
+  char buf[PAGE_SIZE] = {0};
+  char data[PAGE_SIZE] = {0};
+  std::string db_file("test.db");
+  auto dm = DiskManager(db_file, pages_per_segment);
+
+  for (int i = 0; i < 10; i++) {
+    std::memset(data, i, sizeof(data));
+    dm.WritePage(i, data);
+  }
+  for (int i = 0; i < 10; i++) {
+    std::memset(data, i, sizeof(data));
+    dm.ReadPage(i, buf);
+    EXPECT_EQ(std::memcmp(buf, data, sizeof(buf)), 0);
+  }
+
+  // Scenario: pages are spread over segment files of pages_per_segment pages.
+  struct stat stat_buf;
+  ASSERT_EQ(0, stat("test.db", &stat_buf));
+  EXPECT_EQ(pages_per_segment * PAGE_SIZE, stat_buf.st_size);
+  ASSERT_EQ(0, stat("test.db.1", &stat_buf));
+  EXPECT_EQ(pages_per_segment * PAGE_SIZE, stat_buf.st_size);
+  ASSERT_EQ(0, stat("test.db.2", &stat_buf));
+  EXPECT_EQ(2 * PAGE_SIZE, stat_buf.st_size);
+
+  // Scenario: reading from a segment that was never written returns zeros without creating it.
+  char zeros[PAGE_SIZE] = {0};
+  dm.ReadPage(4 * pages_per_segment, buf);
+  EXPECT_EQ(std::memcmp(buf, zeros, sizeof(buf)), 0);
+  EXPECT_NE(0, stat("test.db.4", &stat_buf));
+  dm.ReadPage(4 * pages_per_segment + 1, buf);
+  EXPECT_EQ(std::memcmp(buf, zeros, sizeof(buf)), 0);
+
+  // Scenario: a segment found missing by a read is still created by a write.
+  std::memset(data, 4, sizeof(data));
+  dm.WritePage(4 * pages_per_segment, data);
+  dm.ReadPage(4 * pages_per_segment, buf);
+  EXPECT_EQ(std::memcmp(buf, data, sizeof(buf)), 0);
+  ASSERT_EQ(0, stat("test.db.4", &stat_buf));
+
+  dm.ShutDown();
+
+  // Scenario: writes after shutdown fail rather than recreating the removed files.
+  remove("test.db");
+  remove("test.db.1");
+  dm.WritePage(0, data);
+  dm.WritePage(pages_per_segment, data);
+  EXPECT_NE(0, stat("test.db", &stat_buf));
+  EXPECT_NE(0, stat("test.db.1", &stat_buf));
+}
+
 // NOLINTNEXTLINE
 TEST_F(DiskManagerTest, ReadWriteLogTest) {
   char buf[16] = {0};
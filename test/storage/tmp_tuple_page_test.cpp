@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -19,11 +20,7 @@
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
-  // There are many ways to do this assignment, and this is only one of them.
-  // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
-  // You will get full credit as long as you are correctly using a linear probe hash table.
-
+TEST(TmpTuplePageTest, BasicTest) {
   TmpTuplePage page{};
   page_id_t page_id = 15445;
   page.Init(page_id, PAGE_SIZE);
@@ -48,4 +45,42 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + PAGE_SIZE - 4), 123);
 }
 
+// NOLINTNEXTLINE
+TEST(TmpTuplePageTest, IterateTest) {
+  TmpTuplePage page{};
+  page.Init(1, PAGE_SIZE);
+  ASSERT_TRUE(page.IsEmpty());
+
+  std::vector<Column> columns;
+  columns.emplace_back("A", TypeId::INTEGER);
+  columns.emplace_back("B", TypeId::VARCHAR, 32);
+  Schema schema(columns);
+
+  // Scenario: fill the page, then read the tuples back from their locations and by iterating over the page.
+  std::vector<TmpTuple> locations;
+  for (int32_t i = 0;; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(i % 20, 'x'))}, &schema);
+    TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
+    if (!page.Insert(tuple, &tmp_tuple)) {
+      break;
+    }
+    EXPECT_EQ(1, tmp_tuple.GetPageId());
+    locations.push_back(tmp_tuple);
+  }
+  ASSERT_GT(locations.size(), 100);
+
+  Tuple tuple;
+  for (size_t i = 0; i < locations.size(); i++) {
+    page.Get(locations[i], &tuple);
+    EXPECT_EQ(i, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  }
+  size_t num_tuples = 0;
+  TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
+  for (bool found = page.GetFirstTmpTuple(&tmp_tuple); found; found = page.GetNextTmpTuple(tmp_tuple, &tmp_tuple)) {
+    num_tuples++;
+    EXPECT_EQ(locations[locations.size() - num_tuples], tmp_tuple);
+  }
+  EXPECT_EQ(locations.size(), num_tuples);
+}
+
 }  // namespace bustub
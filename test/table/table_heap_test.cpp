@@ -0,0 +1,356 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_heap_test.cpp
+//
+// Identification: test/table/table_heap_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "concurrency/transaction.h"
+#include "gtest/gtest.h"
+#include "storage/table/free_space_map.h"
+#include "storage/table/table_heap.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+class TableHeapTest : public ::testing::Test {
+ protected:
+  // This function is called before every test.
+  void SetUp() override {
+    remove("test.db");
+    remove("test.log");
+    disk_manager_ = std::make_unique<DiskManager>("test.db");
+    bpm_ = std::make_unique<BufferPoolManagerInstance>(50, disk_manager_.get());
+    lock_manager_ = std::make_unique<LockManager>();
+    log_manager_ = std::make_unique<LogManager>(disk_manager_.get());
+  }
+
+  // This function is called after every test.
+  void TearDown() override {
+    log_manager_.reset();
+    lock_manager_.reset();
+    bpm_.reset();
+    disk_manager_->ShutDown();
+    disk_manager_.reset();
+    remove("test.db");
+    remove("test.log");
+  };
+
+  Tuple MakeTuple(int32_t key) {
+    return Tuple{std::vector<Value>{ValueFactory::GetIntegerValue(key), ValueFactory::GetVarcharValue(padding_)},
+                 &schema_};
+  }
+
+  size_t CountPages(TableHeap *table) {
+    size_t num_pages = 0;
+    page_id_t page_id = table->GetFirstPageId();
+    while (page_id != INVALID_PAGE_ID) {
+      auto page = static_cast<TablePage *>(bpm_->FetchPage(page_id));
+      EXPECT_NE(nullptr, page);
+      page_id_t next_page_id = page->GetNextPageId();
+      bpm_->UnpinPage(page_id, false);
+      page_id = next_page_id;
+      num_pages++;
+    }
+    return num_pages;
+  }
+
+  void CheckTuple(TableHeap *table, const RID &rid, int32_t key, Transaction *txn) {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(rid, &tuple, txn));
+    EXPECT_EQ(key, tuple.GetValue(&schema_, 0).GetAs<int32_t>());
+  }
+
+  std::unique_ptr<DiskManager> disk_manager_;
+  std::unique_ptr<BufferPoolManagerInstance> bpm_;
+  std::unique_ptr<LockManager> lock_manager_;
+  std::unique_ptr<LogManager> log_manager_;
+  Schema schema_{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 128}}};
+  std::string padding_ = std::string(100, 'x');
+};
+
+// NOLINTNEXTLINE
+TEST_F(TableHeapTest, FreeSpaceReuseTest) {
+  Transaction txn(0);
+  TableHeap table(bpm_.get(), lock_manager_.get(), log_manager_.get(), &txn);
+
+  const int num_tuples = 1000;
+  std::vector<RID> rids(num_tuples);
+  for (int i = 0; i < num_tuples; i++) {
+    ASSERT_TRUE(table.InsertTuple(MakeTuple(i), &rids[i], &txn));
+  }
+  size_t num_pages = CountPages(&table);
+  EXPECT_GT(num_pages, 1);
+
+  // Scenario: space freed by deletes all over the table is found and reused instead of extending the table.
+  for (int i = 0; i < num_tuples; i += 2) {
+    ASSERT_TRUE(table.MarkDelete(rids[i], &txn));
+    table.ApplyDelete(rids[i], &txn);
+  }
+  for (int i = 0; i < num_tuples; i += 2) {
+    ASSERT_TRUE(table.InsertTuple(MakeTuple(num_tuples + i), &rids[i], &txn));
+  }
+  EXPECT_EQ(num_pages, CountPages(&table));
+
+  for (int i = 0; i < num_tuples; i++) {
+    CheckTuple(&table, rids[i], i % 2 == 0 ? num_tuples + i : i, &txn);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableHeapTest, FreeSpaceMapSearchTest) {
+  FreeSpaceMap fsm(bpm_.get());
+  ASSERT_TRUE(fsm.AddPage(100, 0, false));
+  ASSERT_TRUE(fsm.AddPage(101, 3000, false));
+  ASSERT_TRUE(fsm.AddPage(102, 1000, false));
+  ASSERT_TRUE(fsm.AddPage(103, 2000, false));
+
+  // Scenario: a search takes the fullest page with enough room, and skips the pages others have claimed.
+  EXPECT_EQ(102, fsm.FindPage(500));
+  EXPECT_EQ(103, fsm.FindPage(500));
+  EXPECT_EQ(101, fsm.FindPage(500));
+  EXPECT_EQ(INVALID_PAGE_ID, fsm.FindPage(500));
+
+  // Scenario: a released page is found with the free space recorded while it was claimed.
+  fsm.UpdatePage(101, 100);
+  fsm.ReleasePage(101);
+  fsm.ReleasePage(103);
+  EXPECT_EQ(103, fsm.FindPage(500));
+  EXPECT_EQ(INVALID_PAGE_ID, fsm.FindPage(500));
+  EXPECT_EQ(101, fsm.FindPage(50));
+
+  // Scenario: the free space recorded for an unclaimed page moves it in the index.
+  fsm.UpdatePage(100, 4000);
+  EXPECT_EQ(100, fsm.FindPage(3500));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableHeapTest, FreeSpaceMapFullBufferPoolTest) {
+  FreeSpaceMap fsm(bpm_.get());
+  ASSERT_TRUE(fsm.AddPage(100, 0, false));
+
+  // Pin every frame, so that the map page cannot be fetched.
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (bpm_->NewPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+
+  // Scenario: a page that cannot be recorded is reported, and the map is left as it was.
+  EXPECT_FALSE(fsm.AddPage(101, PAGE_SIZE, false));
+  EXPECT_EQ(std::vector<page_id_t>({100}), fsm.GetPageIds());
+
+  // Scenario: the free space of a page is still recorded in memory, and searches find it.
+  fsm.UpdatePage(100, PAGE_SIZE / 2);
+  EXPECT_EQ(100, fsm.FindPage(PAGE_SIZE / 4));
+  fsm.ReleasePage(100);
+
+  for (page_id_t pinned_page_id : pinned) {
+    bpm_->UnpinPage(pinned_page_id, false);
+  }
+  ASSERT_TRUE(fsm.AddPage(101, PAGE_SIZE, false));
+  EXPECT_EQ(std::vector<page_id_t>({100, 101}), fsm.GetPageIds());
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableHeapTest, ReopenTest) {
+  Transaction txn(0);
+  page_id_t first_page_id;
+  const int num_tuples = 500;
+  std::vector<RID> rids(num_tuples);
+  size_t num_pages;
+  {
+    TableHeap table(bpm_.get(), lock_manager_.get(), log_manager_.get(), &txn);
+    first_page_id = table.GetFirstPageId();
+    for (int i = 0; i < num_tuples; i++) {
+      ASSERT_TRUE(table.InsertTuple(MakeTuple(i), &rids[i], &txn));
+    }
+    for (int i = 0; i < num_tuples / 2; i++) {
+      ASSERT_TRUE(table.MarkDelete(rids[i], &txn));
+      table.ApplyDelete(rids[i], &txn);
+    }
+    num_pages = CountPages(&table);
+  }
+
+  // Scenario: the free-space map is read back when the table is opened again.
+  {
+    TableHeap table(bpm_.get(), lock_manager_.get(), log_manager_.get(), first_page_id);
+    for (int i = 0; i < num_tuples / 4; i++) {
+      ASSERT_TRUE(table.InsertTuple(MakeTuple(i), &rids[i], &txn));
+    }
+    EXPECT_EQ(num_pages, CountPages(&table));
+  }
+
+  // Scenario: a table without a free-space map gets one built from its pages.
+  auto first_page = static_cast<TablePage *>(bpm_->FetchPage(first_page_id));
+  ASSERT_NE(nullptr, first_page);
+  first_page->SetFreeSpaceMapPageId(INVALID_PAGE_ID);
+  bpm_->UnpinPage(first_page_id, true);
+  {
+    TableHeap table(bpm_.get(), lock_manager_.get(), log_manager_.get(), first_page_id);
+    for (int i = num_tuples / 4; i < num_tuples / 2; i++) {
+      ASSERT_TRUE(table.InsertTuple(MakeTuple(i), &rids[i], &txn));
+    }
+    EXPECT_EQ(num_pages, CountPages(&table));
+    for (int i = 0; i < num_tuples; i++) {
+      CheckTuple(&table, rids[i], i, &txn);
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableHeapTest, IteratorTest) {
+  Transaction txn(0);
+  TableHeap table(bpm_.get(), lock_manager_.get(), log_manager_.get(), &txn);
+
+  const int num_tuples = 1000;
+  std::vector<RID> rids(num_tuples);
+  for (int i = 0; i < num_tuples; i++) {
+    ASSERT_TRUE(table.InsertTuple(MakeTuple(i), &rids[i], &txn));
+  }
+
+  // Scenario: delete every third tuple, and every tuple of the first page and of a page in the middle, which the scan
+  // must skip.
+  page_id_t first_page_id = rids.front().GetPageId();
+  page_id_t middle_page_id = rids[num_tuples / 2].GetPageId();
+  std::vector<bool> deleted(num_tuples);
+  for (int i = 0; i < num_tuples; i++) {
+    if (i % 3 == 0 || rids[i].GetPageId() == first_page_id || rids[i].GetPageId() == middle_page_id) {
+      ASSERT_TRUE(table.MarkDelete(rids[i], &txn));
+      table.ApplyDelete(rids[i], &txn);
+      deleted[i] = true;
+    }
+  }
+
+  int i = 0;
+  for (auto iter = table.Begin(&txn); iter != table.End(); ++iter) {
+    while (deleted[i]) {
+      i++;
+    }
+    ASSERT_LT(i, num_tuples);
+    EXPECT_EQ(rids[i].Get(), iter->GetRid().Get());
+    EXPECT_EQ(i, (*iter).GetValue(&schema_, 0).GetAs<int32_t>());
+    i++;
+  }
+  while (i < num_tuples && deleted[i]) {
+    i++;
+  }
+  EXPECT_EQ(num_tuples, i);
+
+  // Scenario: a scan can start in the middle of a page.
+  ASSERT_TRUE(deleted[num_tuples - 1]);
+  TableIterator iter(&table, rids[num_tuples - 3], &txn);
+  ASSERT_TRUE(iter != table.End());
+  EXPECT_EQ(num_tuples - 3, iter->GetValue(&schema_, 0).GetAs<int32_t>());
+  EXPECT_EQ(num_tuples - 2, (++iter)->GetValue(&schema_, 0).GetAs<int32_t>());
+  EXPECT_TRUE(++iter == table.End());
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableHeapTest, TupleViewTest) {
+  Transaction txn(0);
+  TableHeap table(bpm_.get(), lock_manager_.get(), log_manager_.get(), &txn);
+
+  const int num_tuples = 200;
+  for (int i = 0; i < num_tuples; i++) {
+    RID rid;
+    ASSERT_TRUE(table.InsertTuple(MakeTuple(i), &rid, &txn));
+  }
+
+  // Scenario: the scan hands out views, which are materialized to outlive the page they were read from.
+  std::vector<Tuple> tuples;
+  for (auto iter = table.Begin(&txn); iter != table.End(); ++iter) {
+    EXPECT_FALSE(iter->IsAllocated());
+    tuples.emplace_back(iter->Materialize());
+    EXPECT_TRUE(tuples.back().IsAllocated());
+    EXPECT_EQ(iter->GetRid().Get(), tuples.back().GetRid().Get());
+  }
+  ASSERT_EQ(num_tuples, tuples.size());
+  for (int i = 0; i < num_tuples; i++) {
+    EXPECT_EQ(i, tuples[i].GetValue(&schema_, 0).GetAs<int32_t>());
+    EXPECT_EQ(padding_, tuples[i].GetValue(&schema_, 1).ToString());
+  }
+
+  // Scenario: a copy of the iterator keeps its page while the original moves on.
+  auto iter = table.Begin(&txn);
+  auto copy = iter;
+  while (iter != table.End()) {
+    ++iter;
+  }
+  EXPECT_EQ(0, copy->GetValue(&schema_, 0).GetAs<int32_t>());
+  EXPECT_EQ(1, (++copy)->GetValue(&schema_, 0).GetAs<int32_t>());
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableHeapTest, MorselTest) {
+  Transaction txn(0);
+  TableHeap table(bpm_.get(), lock_manager_.get(), log_manager_.get(), &txn);
+
+  const int num_tuples = 1000;
+  std::vector<RID> rids(num_tuples);
+  for (int i = 0; i < num_tuples; i++) {
+    ASSERT_TRUE(table.InsertTuple(MakeTuple(i), &rids[i], &txn));
+  }
+
+  // Scenario: scanning the morsels one after another visits every tuple once, in table order.
+  size_t num_pages = CountPages(&table);
+  auto morsels = table.GetMorsels(2);
+  ASSERT_EQ((num_pages + 1) / 2, morsels.size());
+  EXPECT_EQ(table.GetFirstPageId(), morsels.front().first_page_id_);
+  EXPECT_EQ(INVALID_PAGE_ID, morsels.back().end_page_id_);
+  int i = 0;
+  for (const auto &morsel : morsels) {
+    for (auto iter = table.Begin(morsel, &txn); iter != table.End(); ++iter) {
+      ASSERT_LT(i, num_tuples);
+      EXPECT_EQ(rids[i].Get(), iter->GetRid().Get());
+      i++;
+    }
+  }
+  EXPECT_EQ(num_tuples, i);
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableHeapTest, ConcurrentInsertTest) {
+  Transaction txn(0);
+  TableHeap table(bpm_.get(), lock_manager_.get(), log_manager_.get(), &txn);
+
+  const int num_threads = 4;
+  const int num_tuples = 500;
+  std::vector<std::vector<RID>> rids(num_threads, std::vector<RID>(num_tuples));
+  std::vector<std::thread> threads;
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&, tid] {
+      Transaction thread_txn(tid + 1);
+      for (int i = 0; i < num_tuples; i++) {
+        EXPECT_TRUE(table.InsertTuple(MakeTuple(tid * num_tuples + i), &rids[tid][i], &thread_txn));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::set<std::pair<page_id_t, uint32_t>> seen;
+  for (int tid = 0; tid < num_threads; tid++) {
+    for (int i = 0; i < num_tuples; i++) {
+      const RID &rid = rids[tid][i];
+      EXPECT_TRUE(seen.emplace(rid.GetPageId(), rid.GetSlotNum()).second);
+      CheckTuple(&table, rid, tid * num_tuples + i, &txn);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -17,12 +17,57 @@
 #include <vector>
 
 #include "buffer/buffer_pool_manager_instance.h"
+#include "execution/expressions/comparison_expression.h"
 #include "gtest/gtest.h"
 #include "logging/common.h"
 #include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
+#include "type/value_factory.h"
 
 namespace bustub {
+// NOLINTNEXTLINE
+TEST(TupleTest, TypedAccessorTest) {
+  Column col1{"a", TypeId::VARCHAR, 20};
+  Column col2{"b", TypeId::SMALLINT};
+  Column col3{"c", TypeId::INTEGER};
+  Column col4{"d", TypeId::BIGINT};
+  Column col5{"e", TypeId::VARCHAR, 16};
+  Column col6{"f", TypeId::INTEGER};
+  Schema schema{std::vector<Column>{col1, col2, col3, col4, col5, col6}};
+  Tuple tuple{std::vector<Value>{ValueFactory::GetVarcharValue("hello"), ValueFactory::GetSmallIntValue(-7),
+                                 ValueFactory::GetIntegerValue(42), ValueFactory::GetBigIntValue(1LL << 40),
+                                 ValueFactory::GetVarcharValue("world"),
+                                 ValueFactory::GetNullValueByType(TypeId::INTEGER)},
+              &schema};
+
+  // The compiled accessors agree with the columns.
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    EXPECT_EQ(schema.GetColumn(i).GetOffset(), schema.GetAccessor(i).offset_);
+    EXPECT_EQ(schema.GetColumn(i).GetType(), schema.GetAccessor(i).type_);
+    EXPECT_EQ(schema.GetColumn(i).IsInlined(), schema.GetAccessor(i).is_inlined_);
+  }
+
+  EXPECT_EQ(-7, tuple.GetAs<int16_t>(&schema, 1));
+  EXPECT_EQ(42, tuple.GetAs<int32_t>(&schema, 2));
+  EXPECT_EQ(1LL << 40, tuple.GetAs<int64_t>(&schema, 3));
+  EXPECT_EQ(BUSTUB_INT32_NULL, tuple.GetAs<int32_t>(&schema, 5));
+  EXPECT_EQ("hello", tuple.GetValue(&schema, 0).ToString());
+  EXPECT_EQ("world", tuple.GetValue(&schema, 4).ToString());
+  EXPECT_EQ(42, tuple.GetValue(&schema, 2).GetAs<int32_t>());
+
+  // Integer comparisons read the columns directly, and fall back to Values for NULLs.
+  ColumnValueExpression col_c{0, 2, TypeId::INTEGER};
+  ColumnValueExpression col_f{0, 5, TypeId::INTEGER};
+  ConstantValueExpression const_42{ValueFactory::GetIntegerValue(42)};
+  ConstantValueExpression const_50{ValueFactory::GetIntegerValue(50)};
+  EXPECT_TRUE(ComparisonExpression(&col_c, &const_42, ComparisonType::Equal).Evaluate(&tuple, &schema).GetAs<bool>());
+  EXPECT_TRUE(
+      ComparisonExpression(&col_c, &const_50, ComparisonType::LessThan).Evaluate(&tuple, &schema).GetAs<bool>());
+  EXPECT_FALSE(
+      ComparisonExpression(&const_50, &col_c, ComparisonType::LessThan).Evaluate(&tuple, &schema).GetAs<bool>());
+  EXPECT_TRUE(ComparisonExpression(&col_f, &const_42, ComparisonType::Equal).Evaluate(&tuple, &schema).IsNull());
+}
+
 // NOLINTNEXTLINE
 TEST(TupleTest, DISABLED_TableHeapTest) {
   // test1: parse create sql statement